@@ -15,8 +15,8 @@
 #include "ElementDoesNotExistInBSTException.h"
 
 // Default Constructor
-template <class ElementType>
-BST<ElementType>::BST(){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>::BST(){
 
     root = NULL;
     elementCount = 0;
@@ -24,342 +24,1238 @@ BST<ElementType>::BST(){
 }
 
 // Parametrized Constructor
-template <class ElementType>
-BST<ElementType>::BST(ElementType& element){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>::BST(ElementType& element){
 
-    BSTNode<ElementType>* newNode = new BSTNode<ElementType>(element);
+    BSTNode<ElementType>* newNode = createNode(element);
     root = newNode;
-    elementCount++;
+    elementCount = 1;
 
 }
 
 // Copy Constructor
-template <class ElementType>
-BST<ElementType>::BST(const BST<ElementType>& aBST){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>::BST(const BST& aBST){
 
-    root = NULL;
-    elementCount = 0;
-    if (aBST.root != NULL){
-        copyR(aBST.root);
-    } else {
-        cout << "Root NULL, copy ends here" << endl;
-    }
+    allocator.reserve(aBST.elementCount);
+    root = cloneNodes(aBST.root);
+    elementCount = aBST.elementCount;
 }
 
-//Description: Helper for copy (basically preOrderTraverse)
-template <class ElementType>
-void BST<ElementType>::copyR(BSTNode<ElementType>* current){
+// Move Constructor
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>::BST(BST&& aBST) noexcept : allocator(std::move(aBST.allocator)){
 
-   insert(current->element);
-    if (current->hasLeft()){
-        copyR(current->left);
-    }
-    if (current->hasRight()){
-        copyR(current->right);
+    root = aBST.root;
+    elementCount = aBST.elementCount;
+    aBST.root = NULL;
+    aBST.elementCount = 0;
+}
+
+//Description: Helper for copy, clones a subtree node for node and returns the
+//             root of the clone. Each node is copied with its size and height,
+//             so nothing is compared or rebalanced, and in pre-order, so a
+//             parent and its left child end up next to each other in the pool.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::cloneNodes(const BSTNode<ElementType>* source){
+
+    BSTNode<ElementType>* clone = NULL;
+    // Nodes still to be copied, and the link in the clone that will hold their copy
+    vector<pair<const BSTNode<ElementType>*, BSTNode<ElementType>**> > toCopy;
+    if (source != NULL)
+        toCopy.push_back(make_pair(source, &clone));
+    try {
+        while (!toCopy.empty()) {
+            const BSTNode<ElementType>* current = toCopy.back().first;
+            BSTNode<ElementType>** link = toCopy.back().second;
+            toCopy.pop_back();
+            BSTNode<ElementType>* copy = createNode(current->element);
+            copy->height = current->height;
+            copy->size = current->size;
+            *link = copy;
+            if (current->hasRight())
+                toCopy.push_back(make_pair(current->right, &copy->right));
+            if (current->hasLeft())
+                toCopy.push_back(make_pair(current->left, &copy->left));
+        }
+    } catch (...) {
+        // The links not filled yet are still NULL, so the partial clone is a tree
+        deleteNodes(clone);
+        throw;
     }
+    return clone;
 }
 
 // Destructor
-template <class ElementType>
-BST<ElementType>::~BST(){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>::~BST(){
+    releaseNodes();
+}
 
-    if (root != NULL) {
-        deleteR(root);
+// Copy Assignment: the copy is made first, so the BST is left unchanged if it throws
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>& BST<ElementType, BalancePolicy, NodeAllocator>::operator=(const BST& aBST){
+
+    if (this != &aBST) {
+        BST copy(aBST);
+        *this = std::move(copy);
     }
+    return *this;
 }
 
-//Description: Helper for destructor (basically postOrderTraversal)
-template <class ElementType>
-void BST<ElementType>::deleteR(BSTNode<ElementType>*& current){
+// Move Assignment
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BST<ElementType, BalancePolicy, NodeAllocator>& BST<ElementType, BalancePolicy, NodeAllocator>::operator=(BST&& aBST) noexcept {
 
-    if (current->hasLeft()){
-        deleteR(current->left);
+    if (this != &aBST) {
+        releaseNodes();
+        allocator = std::move(aBST.allocator);
+        root = aBST.root;
+        elementCount = aBST.elementCount;
+        aBST.root = NULL;
+        aBST.elementCount = 0;
     }
-    if (current->hasRight()){
-        deleteR(current->right);
+    return *this;
+}
+
+//Description: Helper for destructor and move assignment, destroys every node
+//             that cannot be left to the allocator
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::releaseNodes() noexcept {
+
+    // When the allocator frees all its nodes at once and the elements need no
+    // destructor, there is nothing left to do node by node
+    if (!(NodeAllocator::bulkRelease && is_trivially_destructible<ElementType>::value))
+        deleteNodes(root);
+    root = NULL;
+    elementCount = 0;
+}
+
+//Description: Builds a node in storage obtained from the allocator, passing
+//             args on to the constructor of its element
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class... Args>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::createNode(Args&&... args){
+
+    BSTNode<ElementType>* storage = allocator.allocate();
+    try {
+        BSTNode<ElementType>* node = new (storage) BSTNode<ElementType>(in_place, std::forward<Args>(args)...);
+        BST_STATS(counters.nodeAllocated());
+        return node;
+    } catch (...) {
+        allocator.deallocate(storage);
+        throw;
     }
+}
 
-    delete current;
-    current = NULL;
+//Description: Destroys a node and gives its storage back to the allocator
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::destroyNode(BSTNode<ElementType>* node){
+
+    node->~BSTNode<ElementType>();
+    allocator.deallocate(node);
+    BST_STATS(counters.nodeFreed());
+}
+
+//Description: Helper for destructor, frees a subtree with O(1) extra space.
+//             Left children are rotated up until the top node has none, then
+//             the top node is freed and its right subtree takes its place.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::deleteNodes(BSTNode<ElementType>*& current){
+
+    while (current != NULL) {
+        if (current->hasLeft()) {
+            BSTNode<ElementType>* leftChild = current->left;
+            current->left = leftChild->right;
+            leftChild->right = current;
+            current = leftChild;
+        } else {
+            BSTNode<ElementType>* rightChild = current->right;
+            destroyNode(current);
+            current = rightChild;
+        }
+    }
 }
 
 // Description: Returns the number of elements in the BST
 // Time efficiency: O(1)
-template <class ElementType>
-int BST<ElementType>::getElementCount() const {
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::getElementCount() const {
     return elementCount;
 }
 
+//Description: Descends towards target and returns the link that holds it,
+//             or the empty link where it would be inserted. The links visited
+//             on the way down are stored in path.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>** BST<ElementType, BalancePolicy, NodeAllocator>::findLink(const ElementType& target, Path& path){
+
+    SearchKey<ElementType, ElementType> searchKey(target);
+    BSTNode<ElementType>** link = &root;
+    BST_STATS(descentDepth = 0);
+    int order;
+    while (*link != NULL && (order = searchKey.compare(*link)) != 0) {
+        BST_STATS(descentDepth++);
+        path.push(link);
+        if (order < 0)
+            link = &(*link)->right;
+        else
+            link = &(*link)->left;
+    }
+    BST_STATS(descentDepth += (*link != NULL));
+    return link;
+}
+
+//Description: Rebalances the nodes held by the recorded links, bottom-up
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::rebalancePath(Path& path){
+
+    if (!BalancePolicy::rebalancing)
+        return;
+    for (int depth = path.size() - 1; depth >= 0; depth--)
+        BalancePolicy::rebalance(*path[depth]);
+}
+
+//Description: Adds delta to the subtree size of every node held by the recorded
+//             links. They are the ancestors of the node inserted or removed, so
+//             no element is compared again.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::resizeAncestors(Path& path, int delta){
+
+    for (int depth = 0; depth < path.size(); depth++)
+        (*path[depth])->size += delta;
+}
+
 // Description: Inserts a new element into the BST
 // Time efficiency: O(log2 n)
 // Pre Condition: Element not already in BST
 // Post Condition: BST is still a Binary Search Tree and element count incrememented by 1
-template <class ElementType>
-void BST<ElementType>::insert(const ElementType& newElement) throw(ElementAlreadyExistsInBSTException){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::insert(const ElementType& newElement){
+    insertElement(newElement);
+}
 
-    if (root == NULL){
-        BSTNode<ElementType>* newNode = new BSTNode<ElementType>(newElement);
-        root = newNode;
-        elementCount++;
-    } else {
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::insert(ElementType&& newElement){
+    insertElement(std::move(newElement));
+}
+
+//Description: Helper for both inserts, copies or moves newElement into a new node
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Element>
+void BST<ElementType, BalancePolicy, NodeAllocator>::insertElement(Element&& newElement){
 
-        bool success = insertR(newElement, root);
-        if (!success){
+    if constexpr (BalancePolicy::splaying) {
+        int depth;
+        int order = BalancePolicy::splay(root, SearchKey<ElementType, ElementType>(newElement), depth);
+        if (order == 0){
+            BST_STATS(counters.record(INSERT_OPERATION, depth, depth));
             throw ElementAlreadyExistsInBSTException("Element already present in BST");
         }
+        linkAtRoot(createNode(std::forward<Element>(newElement)), order);
+        BST_STATS(counters.record(INSERT_OPERATION, depth, depth + 1));
+        return;
+    }
+
+    Path path;
+    BSTNode<ElementType>** link = findLink(newElement, path);
+    if (*link != NULL){
+        throw ElementAlreadyExistsInBSTException("Element already present in BST");
     }
+
+    *link = createNode(std::forward<Element>(newElement));
+    elementCount++;
+    resizeAncestors(path, 1);
+    rebalancePath(path);
+    BST_STATS(counters.record(INSERT_OPERATION, descentDepth, descentDepth + 1));
 }
 
-//Description: Helper for insert
-template <class ElementType>
-bool BST<ElementType>::insertR(const ElementType& element, BSTNode<ElementType>* current){
+//Description: Helper for the inserts of a splaying policy, makes newNode the root
+//             above the old one, just splayed next to it. The old root keeps the
+//             subtree on its side of newNode and hands the other one over.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::linkAtRoot(BSTNode<ElementType>* newNode, int order){
 
-    if (current->element == element) {
-        return false;
-    } else if (current->element < element){
-        if (current->hasRight()){
-            return insertR(element, current->right);
+    if (root != NULL) {
+        if (order < 0) {        // old root less than newNode
+            newNode->left = root;
+            newNode->right = root->right;
+            root->right = NULL;
         } else {
-            BSTNode<ElementType>* newNode = new BSTNode<ElementType>(element);
-            current->right = newNode;
+            newNode->right = root;
+            newNode->left = root->left;
+            root->left = NULL;
         }
-    } else {
-        if (current->hasLeft()) {
-            return insertR(element, current->left);
-        } else {
-            BSTNode<ElementType>* newNode = new BSTNode<ElementType>(element);
-            current->left = newNode;
+        root->updateSize();
+        newNode->updateSize();
+    }
+    root = newNode;
+    elementCount++;
+}
+
+// Description: Builds a new element in place from the constructor arguments
+//              of ElementType and inserts it into the BST
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class... Args>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::emplace(Args&&... args){
+
+    // The element has to exist before it can be compared, so the node is
+    // built first and given back if the element turns out to be a duplicate
+    BSTNode<ElementType>* newNode = createNode(std::forward<Args>(args)...);
+    if constexpr (BalancePolicy::splaying) {
+        int depth;
+        int order = BalancePolicy::splay(root, SearchKey<ElementType, ElementType>(newNode->element), depth);
+        if (order == 0){
+            destroyNode(newNode);
+            BST_STATS(counters.record(INSERT_OPERATION, depth, depth));
+            throw ElementAlreadyExistsInBSTException("Element already present in BST");
         }
+        linkAtRoot(newNode, order);
+        BST_STATS(counters.record(INSERT_OPERATION, depth, depth + 1));
+        return newNode->element;
     }
 
+    Path path;
+    BSTNode<ElementType>** link = findLink(newNode->element, path);
+    if (*link != NULL){
+        destroyNode(newNode);
+        throw ElementAlreadyExistsInBSTException("Element already present in BST");
+    }
+
+    *link = newNode;
     elementCount++;
-    return true;
+    resizeAncestors(path, 1);
+    rebalancePath(path);
+    BST_STATS(counters.record(INSERT_OPERATION, descentDepth, descentDepth + 1));
+    return newNode->element;
+}
+
+// Description: Replaces the content of the BST with the elements of [first, last),
+//              linked directly into a tree of minimal height.
+// Time efficiency: O(n), no comparisons
+// Pre Condition: [first, last) is sorted and holds no duplicates
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class ForwardIterator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::buildFromSorted(ForwardIterator first, ForwardIterator last){
+
+    deleteNodes(root);
+    elementCount = 0;
+    int count = (int) distance(first, last);
+    root = buildBalanced(first, count);
+    elementCount = count;
+}
+
+//Description: Helper for buildFromSorted, links the next count elements into
+//             a height-optimal subtree and returns its root. The two subtrees
+//             differ by at most one element, so the result is also an AVL tree.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class ForwardIterator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::buildBalanced(ForwardIterator& next, int count){
+
+    if (count == 0)
+        return NULL;
+
+    int leftCount = (count - 1) / 2;
+    BSTNode<ElementType>* leftSubtree = buildBalanced(next, leftCount);
+    BSTNode<ElementType>* current;
+    try {
+        current = createNode(*next);
+    } catch (...) {
+        deleteNodes(leftSubtree);
+        throw;
+    }
+    ++next;
+    current->left = leftSubtree;
+    try {
+        current->right = buildBalanced(next, count - 1 - leftCount);
+    } catch (...) {
+        deleteNodes(current);
+        throw;
+    }
+
+    // The right subtree holds at least as many elements, so it is the taller one
+    int rightHeight = (current->right == NULL) ? 0 : current->right->height;
+    current->height = 1 + rightHeight;
+    current->size = count;
+    return current;
+}
+
+// Description: Same as buildFromSorted, but sorts [first, last) first. Of several
+//              equal elements the first one is kept, the others are appended
+//              to duplicates (when given) in a single pass.
+// Time efficiency: O(n log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class InputIterator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::buildFromUnsorted(InputIterator first, InputIterator last, vector<ElementType>* duplicates){
+
+    vector<ElementType> elements(first, last);
+    stable_sort(elements.begin(), elements.end());
+
+    // Equal elements are now adjacent, in their original order
+    size_t uniqueCount = 0;
+    int duplicateCount = 0;
+    for (size_t i = 0; i < elements.size(); i++) {
+        if (uniqueCount > 0 && elements[uniqueCount - 1] == elements[i]) {
+            duplicateCount++;
+            if (duplicates != NULL)
+                duplicates->push_back(std::move(elements[i]));
+        } else {
+            if (uniqueCount != i)
+                elements[uniqueCount] = std::move(elements[i]);
+            uniqueCount++;
+        }
+    }
+
+    buildFromSorted(make_move_iterator(elements.begin()), make_move_iterator(elements.begin() + uniqueCount));
+    return duplicateCount;
+}
+
+//Description: Returns the node holding an element equal to key, NULL if there is none
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::findNode(const Key& key) const {
+
+    SearchKey<ElementType, Key> searchKey(key);
+    if constexpr (BalancePolicy::splaying) {
+        int depth;
+        BSTNode<ElementType>* found = BalancePolicy::access(root, searchKey, depth);
+        BST_STATS(counters.record(RETRIEVE_OPERATION, depth, depth));
+        return found;
+    }
+
+    BSTNode<ElementType>* current = root;
+    BST_STATS(int depth = 0);
+    int order;
+    while (current != NULL && (order = searchKey.compare(current)) != 0) {
+        BST_STATS(depth++);
+        if (order < 0)
+            current = current->right;
+        else
+            current = current->left;
+    }
+    BST_STATS(depth += (current != NULL));
+    BST_STATS(counters.record(RETRIEVE_OPERATION, depth, depth));
+    return current;
 }
 
 // Description: Retrieves a target element from the BST
 // Time efficiency: O(log2 n)
-template <class ElementType>
-ElementType& BST<ElementType>::retrieve(const ElementType& targetElement) const throw(ElementDoesNotExistInBSTException){
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::retrieve(const ElementType& targetElement) const {
     if (root == NULL){
         throw ElementDoesNotExistInBSTException("BST is empty");
-    } else {
-        try {
-            return retrieveR(targetElement, root);
-        } catch(ElementDoesNotExistInBSTException& e){
-            throw e;
-        }
     }
+
+    BSTNode<ElementType>* found = findNode(targetElement);
+    if (found == NULL){
+        throw ElementDoesNotExistInBSTException("Element not found in BST");
+    }
+    return found->element;
 }
 
-//Description: Helper for retrieve
-template <class ElementType>
-ElementType& BST<ElementType>::retrieveR(const ElementType& targetElement, BSTNode<ElementType>* current) const throw(ElementDoesNotExistInBSTException){
+// Description: Returns a pointer to the element equal to key, NULL if there is
+//              none. Never throws, so misses cost no more than hits.
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+ElementType* BST<ElementType, BalancePolicy, NodeAllocator>::find(const Key& key) const {
+    BSTNode<ElementType>* found = findNode(key);
+    return (found == NULL) ? NULL : &found->element;
+}
 
-    if (current->element == targetElement){
-        return current->element;
-    }
-    if (current->element < targetElement){
-        if (current->hasRight()){
-            return retrieveR(targetElement, current->right);
+// Description: Returns true if an element equal to key is in the BST
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+bool BST<ElementType, BalancePolicy, NodeAllocator>::contains(const Key& key) const {
+    return findNode(key) != NULL;
+}
+
+// Description: Looks up every key of keys at once, see BST.h
+// Time efficiency: O(k log2 n) for k keys
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+int BST<ElementType, BalancePolicy, NodeAllocator>::retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results) const {
+
+    results.assign(keys.size(), NULL);
+    int hits = 0;
+    BSTNode<ElementType>* cursors[BATCH_WIDTH];
+    SearchKey<ElementType, Key> searchKeys[BATCH_WIDTH];
+    BST_STATS(int depths[BATCH_WIDTH]);
+
+    for (size_t first = 0; first < keys.size(); first += BATCH_WIDTH) {
+        int width = (int) (keys.size() - first < (size_t) BATCH_WIDTH ? keys.size() - first : BATCH_WIDTH);
+        int descending = (root == NULL) ? 0 : width;
+        for (int i = 0; i < width; i++) {
+            cursors[i] = root;
+            searchKeys[i] = SearchKey<ElementType, Key>(keys[first + i]);
+            BST_STATS(depths[i] = 0);
         }
-    } else {
-        if (current->hasLeft()){
-            return retrieveR(targetElement, current->left);
+
+        // One level of every unfinished descent per round
+        while (descending > 0) {
+            for (int i = 0; i < width; i++) {
+                BSTNode<ElementType>* current = cursors[i];
+                if (current == NULL)
+                    continue;
+                int order = searchKeys[i].compare(current);
+                BST_STATS(depths[i]++);
+                if (order == 0) {
+                    results[first + i] = &current->element;
+                    hits++;
+                    current = NULL;
+                } else {
+                    current = (order < 0) ? current->right : current->left;
+                    if (current != NULL)
+                        __builtin_prefetch(current);
+                }
+                if (current == NULL) {
+                    descending--;
+                    BST_STATS(counters.record(RETRIEVE_OPERATION, depths[i], depths[i]));
+                }
+                cursors[i] = current;
+            }
         }
     }
-    throw ElementDoesNotExistInBSTException("Element not found in BST");
+    return hits;
 }
 
 // Description: traverse the BST in order and "visit" each element
 // Time efficiency: O(n)
-template <class ElementType>
-void BST<ElementType>::traverseInOrder(void visit(ElementType&)) const {
-    if (root != NULL)
-        traverseInOrderR(visit, root);
-    else
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::traverseInOrder(void visit(ElementType&)) const {
+    if (root == NULL) {
         cout << "Root NULL, traverse ends here" << endl;
+        return;
+    }
+    traverseInOrder<void (*)(ElementType&)>(visit);
 }
 
+// Description: Same as traverseInOrder above, for visitors that carry state
+// Time efficiency: O(n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Visitor>
+void BST<ElementType, BalancePolicy, NodeAllocator>::traverseInOrder(Visitor& visitor) const {
+    traverse(visitor, IN_ORDER);
+}
+
+// Description: Visits the elements in the given order until the visitor returns false
+// Time efficiency: O(n), O(height) extra space
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Visitor>
+bool BST<ElementType, BalancePolicy, NodeAllocator>::traverse(Visitor&& visitor, TraversalOrder order) const {
+
+    // Holds the ancestors still to be visited or to be descended to the right
+    // from, so it never grows beyond the height of the tree
+    vector<BSTNode<ElementType>*> ancestors;
+    BSTNode<ElementType>* current = root;
+
+    if (order == PRE_ORDER) {
+        while (current != NULL || !ancestors.empty()) {
+            if (current == NULL) {
+                current = ancestors.back()->right;
+                ancestors.pop_back();
+                continue;
+            }
+            if (!visitElement(visitor, current->element))
+                return false;
+            ancestors.push_back(current);
+            current = current->left;
+        }
+    } else if (order == IN_ORDER) {
+        while (current != NULL || !ancestors.empty()) {
+            while (current != NULL) {
+                ancestors.push_back(current);
+                current = current->left;
+            }
+            current = ancestors.back();
+            ancestors.pop_back();
+            if (!visitElement(visitor, current->element))
+                return false;
+            current = current->right;
+        }
+    } else {
+        // A node is visited when coming back up from its right subtree (or from
+        // its left one when it has no right one)
+        BSTNode<ElementType>* lastVisited = NULL;
+        while (current != NULL || !ancestors.empty()) {
+            if (current != NULL) {
+                ancestors.push_back(current);
+                current = current->left;
+                continue;
+            }
+            BSTNode<ElementType>* parent = ancestors.back();
+            if (parent->right != NULL && parent->right != lastVisited) {
+                current = parent->right;
+            } else {
+                if (!visitElement(visitor, parent->element))
+                    return false;
+                lastVisited = parent;
+                ancestors.pop_back();
+            }
+        }
+    }
+    return true;
+}
+
+// Description: Iterator to the smallest element
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator BST<ElementType, BalancePolicy, NodeAllocator>::begin() const {
+    iterator first(root);
+    first.descendLeftmost(root);
+    return first;
+}
+
+// Description: Iterator past the largest element
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator BST<ElementType, BalancePolicy, NodeAllocator>::end() const {
+    return iterator(root);
+}
+
+// Description: Returns an iterator to the first element not less than key
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator BST<ElementType, BalancePolicy, NodeAllocator>::lower_bound(const Key& key) const {
+    iterator result(root);
+    size_t depth = 0;   // length of the path to the last node not less than key
+    for (BSTNode<ElementType>* current = root; current != NULL; ) {
+        result.path.push_back(current);
+        if (current->element < key) {
+            current = current->right;
+        } else {
+            depth = result.path.size();
+            current = current->left;
+        }
+    }
+    result.path.resize(depth);
+    return result;
+}
+
+// Description: Returns an iterator to the first element greater than key
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator BST<ElementType, BalancePolicy, NodeAllocator>::upper_bound(const Key& key) const {
+    iterator result(root);
+    size_t depth = 0;   // length of the path to the last node greater than key
+    for (BSTNode<ElementType>* current = root; current != NULL; ) {
+        result.path.push_back(current);
+        if (current->element < key || current->element == key) {
+            current = current->right;
+        } else {
+            depth = result.path.size();
+            current = current->left;
+        }
+    }
+    result.path.resize(depth);
+    return result;
+}
 
-//Description: Helper for traversInOrder
-template <class ElementType>
-void BST<ElementType>::traverseInOrderR(void visit(ElementType&), BSTNode<ElementType>* current) const {
-    if (current->hasLeft())
-        traverseInOrderR(visit, current->left);
-    visit(current->element);
-    if (current->hasRight())
-        traverseInOrderR(visit, current->right);
+// Description: Returns the range of elements equal to key
+// Time efficiency: O(log2 n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+pair<typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator, typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator>
+BST<ElementType, BalancePolicy, NodeAllocator>::equal_range(const Key& key) const {
+    return make_pair(lower_bound(key), upper_bound(key));
+}
+
+// Description: Returns an immutable copy of the BST laid out for fast searches
+// Time efficiency: O(n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+FrozenBST<ElementType> BST<ElementType, BalancePolicy, NodeAllocator>::freeze() const {
+
+    vector<ElementType> inOrder;
+    inOrder.reserve(elementCount);
+    vector<BSTNode<ElementType>*> ancestors;
+    BSTNode<ElementType>* current = root;
+    while (current != NULL || !ancestors.empty()) {
+        while (current != NULL) {
+            ancestors.push_back(current);
+            current = current->left;
+        }
+        current = ancestors.back();
+        ancestors.pop_back();
+        inOrder.push_back(current->element);
+        current = current->right;
+    }
+
+    return FrozenBST<ElementType>(make_move_iterator(inOrder.begin()), make_move_iterator(inOrder.end()));
 }
 
 // COUNT FUNCTIONS
-template <class ElementType>
-int BST<ElementType>::nodesCount() const {
-    return countR(root);
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::nodesCount() const {
+    return (root == NULL) ? 0 : root->size;
 }
-template <class ElementType>
-int BST<ElementType>::countR(BSTNode<ElementType>* current) const {
-    if (current == NULL)
-        return 0;
-    else
-        return 1 + countR(current->left) + countR(current->right);
+
+// HEIGHT FUNCTIONS
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::height() const {
+    int maxHeight = 0;
+    vector<pair<BSTNode<ElementType>*, int> > toVisit;
+    if (root != NULL)
+        toVisit.push_back(make_pair(root, 1));
+    while (!toVisit.empty()) {
+        BSTNode<ElementType>* current = toVisit.back().first;
+        int currentHeight = toVisit.back().second;
+        toVisit.pop_back();
+        if (currentHeight > maxHeight)
+            maxHeight = currentHeight;
+        if (current->hasLeft())
+            toVisit.push_back(make_pair(current->left, currentHeight + 1));
+        if (current->hasRight())
+            toVisit.push_back(make_pair(current->right, currentHeight + 1));
+    }
+    return maxHeight;
 }
 
+// Description: Reports the shape of the BST, its memory use and, in builds with
+//              BST_ENABLE_STATS, its operation counters
+// Time efficiency: O(n)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTStats BST<ElementType, BalancePolicy, NodeAllocator>::stats() const {
+    BSTStats report;
+    BST_STATS(counters.report(report));
+
+    long depthTotal = 0;
+    vector<pair<BSTNode<ElementType>*, int> > toVisit;
+    if (root != NULL)
+        toVisit.push_back(make_pair(root, 1));
+    while (!toVisit.empty()) {
+        BSTNode<ElementType>* current = toVisit.back().first;
+        int depth = toVisit.back().second;
+        toVisit.pop_back();
+        if ((int) report.depthHistogram.size() < depth)
+            report.depthHistogram.resize(depth, 0);
+        report.depthHistogram[depth - 1]++;
+        depthTotal += depth;
+        if (current->hasLeft())
+            toVisit.push_back(make_pair(current->left, depth + 1));
+        if (current->hasRight())
+            toVisit.push_back(make_pair(current->right, depth + 1));
+    }
+
+    // A tree of n nodes is at least as high as the number of bits of n
+    int minimalHeight = 0;
+    for (int remaining = elementCount; remaining > 0; remaining /= 2)
+        minimalHeight++;
+
+    report.elementCount = elementCount;
+    report.height = (int) report.depthHistogram.size();
+    report.averageDepth = (elementCount == 0) ? 0 : (double) depthTotal / elementCount;
+    report.balanceFactor = (elementCount == 0) ? 1 : (double) report.height / minimalHeight;
+    report.bytesInUse = elementCount * sizeof(BSTNode<ElementType>);
+    report.bytesReserved = reservedBytes(allocator, elementCount);
+    return report;
+}
 
 // MIN FUNCTIONS
-template <class ElementType>
-ElementType& BST<ElementType>::min() const {
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::min() const {
     if (root == NULL) {
         throw ElementDoesNotExistInBSTException("No Min element");
-    } else {
-        return minR(root);
     }
-}
-template <class ElementType>
-ElementType& BST<ElementType>::minR(BSTNode<ElementType>* current) const {
-    if (current->hasLeft())
-        return minR(current->left);
-    else
-        return current->element;
+    BSTNode<ElementType>* current = root;
+    while (current->hasLeft())
+        current = current->left;
+    return current->element;
 }
 
 // MAX FUNCTIONS
-template <class ElementType>
-ElementType& BST<ElementType>::max() const {
-    if (root == NULL)
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::max() const {
+    if (root == NULL) {
         throw ElementDoesNotExistInBSTException("No Max element");
-    else
-        return maxR(root);
-}
-template <class ElementType>
-ElementType& BST<ElementType>::maxR(BSTNode<ElementType>* current) const {
-    if (current->hasRight())
-        return maxR(current->right);
-    else
-        return current->element;
+    }
+    BSTNode<ElementType>* current = root;
+    while (current->hasRight())
+        current = current->right;
+    return current->element;
 }
 
 // DUPLICATE COUNTS (Either 1 or 0 since no dups aloud)
-template <class ElementType>
-int BST<ElementType>::duplicate(const ElementType& targetElement) const {
-    return duplicateR(root, targetElement);
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::duplicate(const ElementType& targetElement) const {
+    return contains(targetElement) ? 1 : 0;
 }
-template <class ElementType>
-int BST<ElementType>::duplicateR(BSTNode<ElementType>* current, const ElementType& target) const {
-    if (current == NULL)
-        return 0;
-    else if (current->element == target)
-        return 1 + duplicateR(current->left, target) + duplicateR(current->right, target);
-    else
-        return 0 + duplicateR(current->left, target) + duplicateR(current->right, target);
-}
-
-
-template <class ElementType>
-void BST<ElementType>::remove(const ElementType& targetElement) throw(ElementDoesNotExistInBSTException) {
-
-    removeR(root, targetElement);
-//    if (root == NULL) {
-//        throw ElementDoesNotExistInBSTException("BST is empty");
-//    } else {
-//        BSTNode<ElementType>* parent = NULL;
-//        BSTNode<ElementType>* current = root;
-//        bool found = false;
-//
-//        while (current != NULL && !found) {
-//            if (current->element == targetElement) {
-//                found = true;
-//            } else {
-//                parent = current;
-//                if (current->element < targetElement) {
-//                    current = current->right;
-//                } else {
-//                    current = current->left;
-//                }
-//            }
-//        }
-//
-//        if (!found) {
-//            throw ElementDoesNotExistInBSTException("Element not found");
-//        }
-//
-//        // cases
-//        if (current->isLeaf()) {
-//
-//            cout << "Element is a leaf" << endl;
-//
-//            if (parent->right->element == current->element)
-//                parent->right = NULL;
-//            else
-//                parent->left = NULL;
-//            delete current;
-//            current = NULL;
-//
-//        } else if (current->hasLeft() && !current->hasRight()) {
-//
-//            cout << "Element has empty right" << endl;
-//
-//            if (parent->right->element == current->element)
-//                parent->right = current->left;
-//            else
-//                parent->left = current->left;
-//            delete current;
-//            current = NULL;
-//
-//        } else if (!current->hasLeft() && current->hasRight()) {
-//
-//            cout << "Element has empty left" << endl;
-//
-//            if (parent->right->element == current->element)
-//                parent->right = current->right;
-//            else
-//                parent->left = current->right;
-//            delete current;
-//            current = NULL;
-//
-//        } else {
-//
-//            cout << "Element has no empty children" << endl;
-//
-//            ElementType predecessor = findPredecessor(current);
-//            remove(predecessor);
-//            current->element = predecessor;
-//
-//        }
-//    }
-}
-
-template <class ElementType>
-void BST<ElementType>::removeR(BSTNode<ElementType>*& current, const ElementType& target) {
-    if (current == NULL) {
-        throw ElementDoesNotExistInBSTException("Element not found");
+
+// ORDER STATISTICS
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+int BST<ElementType, BalancePolicy, NodeAllocator>::rank(const Key& key) const {
+    int lessCount = 0;
+    BSTNode<ElementType>* current = root;
+    while (current != NULL) {
+        if (current->element < key) {
+            lessCount += current->leftSize() + 1;
+            current = current->right;
+        } else {
+            current = current->left;
+        }
+    }
+    return lessCount;
+}
+
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::select(int index) const {
+    if (index < 0 || index >= nodesCount()) {
+        throw ElementDoesNotExistInBSTException("Index out of range");
     }
-    if (current->element == target){
-        /// 4 CASES
-        if (current->isLeaf()) { // 1 - Leaf
-            cout << "Element is leaf" << endl;
-            delete current;
-            current = NULL;
-            return;
-        } else if (current->hasLeft() && !current->hasRight()) { // 2 - has left but not right
-            cout << "Element has no right" << endl;
-            delete current;
+    BSTNode<ElementType>* current = root;
+    while (index != current->leftSize()) {
+        if (index < current->leftSize()) {
             current = current->left;
-            return;
-        } else if (!current->hasLeft() && current->hasRight()) { // 3 - has right but not left
-            cout << "Element has no left" << endl;
-            delete current;
+        } else {
+            index -= current->leftSize() + 1;
+            current = current->right;
+        }
+    }
+    return current->element;
+}
+
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+ElementType& BST<ElementType, BalancePolicy, NodeAllocator>::median() const {
+    if (root == NULL) {
+        throw ElementDoesNotExistInBSTException("No Median element");
+    }
+    return select((nodesCount() - 1) / 2);
+}
+
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+int BST<ElementType, BalancePolicy, NodeAllocator>::countRange(const Key& low, const Key& high) const {
+    int count = rank(high) - rank(low);
+    return (count > 0) ? count : 0;
+}
+
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+typename BST<ElementType, BalancePolicy, NodeAllocator>::iterator BST<ElementType, BalancePolicy, NodeAllocator>::nth(int index) const {
+    iterator result(root);
+    if (index < 0 || index >= nodesCount())
+        return result;
+    BSTNode<ElementType>* current = root;
+    while (true) {
+        result.path.push_back(current);
+        if (index == current->leftSize())
+            return result;
+        if (index < current->leftSize()) {
+            current = current->left;
+        } else {
+            index -= current->leftSize() + 1;
             current = current->right;
-            return;
-        } else { // 4 - has both
-            cout << "Element has both" << endl;
-            ElementType pre = maxR(current->left);
-            remove(pre);
-            current->element = pre;
-            return;
         }
-    } else if (current->element < target) {
-        removeR(current->right, target);
+    }
+}
+
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+void BST<ElementType, BalancePolicy, NodeAllocator>::remove(const ElementType& targetElement) {
+
+    if constexpr (BalancePolicy::splaying) {
+        SearchKey<ElementType, ElementType> searchKey(targetElement);
+        int depth;
+        if (BalancePolicy::splay(root, searchKey, depth) != 0) {
+            BST_STATS(counters.record(REMOVE_OPERATION, depth, depth));
+            throw ElementDoesNotExistInBSTException("Element not found");
+        }
+        // Splaying the left subtree, all less than the target, for the target
+        // brings its largest node to its top, with no right child
+        BSTNode<ElementType>* toDelete = root;
+        if (toDelete->hasLeft()) {
+            int leftDepth;
+            BalancePolicy::splay(toDelete->left, searchKey, leftDepth);
+            BST_STATS(depth += leftDepth);
+            root = toDelete->left;
+            root->right = toDelete->right;
+            root->updateSize();
+        } else {
+            root = toDelete->right;
+        }
+        destroyNode(toDelete);
+        elementCount--;
+        BST_STATS(counters.record(REMOVE_OPERATION, depth, depth));
+        return;
+    }
+
+    Path path;
+    BSTNode<ElementType>** link = findLink(targetElement, path);
+    if (*link == NULL) {
+        BST_STATS(counters.record(REMOVE_OPERATION, descentDepth, descentDepth));
+        throw ElementDoesNotExistInBSTException("Element not found");
+    }
+
+    BSTNode<ElementType>* toDelete = *link;
+    resizeAncestors(path, -1);
+    if (!toDelete->hasLeft()) {          // leaf or right child only
+        *link = toDelete->right;
+    } else if (!toDelete->hasRight()) {  // left child only
+        *link = toDelete->left;
+    } else {                             // both: in-order predecessor takes its place
+        int nodeDepth = path.size();
+        if (BalancePolicy::rebalancing)
+            path.push(link);
+        BSTNode<ElementType>** maxLink = &toDelete->left;
+        while ((*maxLink)->hasRight()) {
+            if (BalancePolicy::rebalancing)
+                path.push(maxLink);
+            (*maxLink)->size--;
+            maxLink = &(*maxLink)->right;
+        }
+        BSTNode<ElementType>* predecessor = *maxLink;
+        *maxLink = predecessor->left;
+        predecessor->left = toDelete->left;
+        predecessor->right = toDelete->right;
+        predecessor->size = toDelete->size - 1;
+        *link = predecessor;
+        // The path went through the deleted node's left link, which now belongs to the predecessor
+        if (path.size() > nodeDepth + 1)
+            path[nodeDepth + 1] = &predecessor->left;
+    }
+    destroyNode(toDelete);
+    elementCount--;
+    rebalancePath(path);
+    BST_STATS(counters.record(REMOVE_OPERATION, descentDepth, descentDepth));
+}
+
+// SPLIT AND JOIN
+
+//Description: Links middle between left and right and returns the root. With
+//             AVLPolicy the shorter tree is hung from the spine of the taller one
+//             at the level of its own height, then rebalanced on the way back up.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::join(BSTNode<ElementType>* left, BSTNode<ElementType>* middle, BSTNode<ElementType>* right){
+
+    if (BalancePolicy::rebalancing) {
+        int leftHeight = (left == NULL) ? 0 : left->height;
+        int rightHeight = (right == NULL) ? 0 : right->height;
+        if (leftHeight > rightHeight + 1) {
+            left->right = join(left->right, middle, right);
+            left->updateSize();
+            BalancePolicy::rebalance(left);
+            return left;
+        }
+        if (rightHeight > leftHeight + 1) {
+            right->left = join(left, middle, right->left);
+            right->updateSize();
+            BalancePolicy::rebalance(right);
+            return right;
+        }
+    }
+    middle->left = left;
+    middle->right = right;
+    middle->updateSize();
+    BalancePolicy::rebalance(middle);
+    return middle;
+}
+
+//Description: Same as join, without a middle node
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::joinTrees(BSTNode<ElementType>* left, BSTNode<ElementType>* right){
+
+    if (left == NULL)
+        return right;
+    BSTNode<ElementType>* middle = detachMax(left);
+    return join(left, middle, right);
+}
+
+//Description: Unlinks the largest node of a non-empty subtree and returns it.
+//             The nodes above it are resized and rebalanced bottom-up.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::detachMax(BSTNode<ElementType>*& subtree){
+
+    Path path;
+    BSTNode<ElementType>** link = &subtree;
+    while ((*link)->hasRight()) {
+        path.push(link);
+        link = &(*link)->right;
+    }
+    BSTNode<ElementType>* max = *link;
+    *link = max->left;
+    max->left = NULL;
+    for (int depth = path.size() - 1; depth >= 0; depth--) {
+        (*path[depth])->updateSize();
+        BalancePolicy::rebalance(*path[depth]);
+    }
+    return max;
+}
+
+//Description: Splits subtree into the nodes less than key and the nodes greater,
+//             and returns the node equal to key, unlinked (NULL if none). The
+//             nodes passed on the way down are joined into less and greater
+//             bottom-up, with their subtree on the far side of key.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::split(BSTNode<ElementType>* subtree, const Key& key, BSTNode<ElementType>*& less, BSTNode<ElementType>*& greater){
+
+    SearchKey<ElementType, Key> searchKey(key);
+    Path path;
+    BSTNode<ElementType>** link = &subtree;
+    int order;
+    while (*link != NULL && (order = searchKey.compare(*link)) != 0) {
+        path.push(link);
+        if (order < 0)
+            link = &(*link)->right;
+        else
+            link = &(*link)->left;
+    }
+
+    BSTNode<ElementType>* found = *link;
+    less = NULL;
+    greater = NULL;
+    if (found != NULL) {
+        less = found->left;
+        greater = found->right;
+        found->left = NULL;
+        found->right = NULL;
+        found->size = 1;
+        found->height = 1;
+    }
+    for (int depth = path.size() - 1; depth >= 0; depth--) {
+        BSTNode<ElementType>* node = *path[depth];
+        if (link == &node->right)
+            less = join(node->left, node, less);
+        else
+            greater = join(greater, node, node->right);
+        link = path[depth];
+    }
+    return found;
+}
+
+//Description: Splits subtree into the nodes less than key and the others
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+void BST<ElementType, BalancePolicy, NodeAllocator>::splitLess(BSTNode<ElementType>* subtree, const Key& key, BSTNode<ElementType>*& less, BSTNode<ElementType>*& notLess){
+
+    SearchKey<ElementType, Key> searchKey(key);
+    Path path;
+    BSTNode<ElementType>** link = &subtree;
+    while (*link != NULL) {
+        path.push(link);
+        if (searchKey.compare(*link) < 0)
+            link = &(*link)->right;
+        else
+            link = &(*link)->left;
+    }
+
+    less = NULL;
+    notLess = NULL;
+    for (int depth = path.size() - 1; depth >= 0; depth--) {
+        BSTNode<ElementType>* node = *path[depth];
+        if (link == &node->right)
+            less = join(node->left, node, less);
+        else
+            notLess = join(notLess, node, node->right);
+        link = path[depth];
+    }
+}
+
+// SET OPERATIONS
+
+//Description: Runs leftTask and rightTask, on two threads when parallel
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class LeftTask, class RightTask>
+void BST<ElementType, BalancePolicy, NodeAllocator>::forkJoin(bool parallel, LeftTask&& leftTask, RightTask&& rightTask){
+
+    future<void> rightDone;
+    if (parallel) {
+        try {
+            rightDone = async(launch::async, rightTask);
+        } catch (system_error&) {
+            parallel = false;   // no thread to spare, run it here
+        }
+    }
+    leftTask();
+    if (parallel)
+        rightDone.get();
+    else
+        rightTask();
+}
+
+//Description: Number of times a set operation forks, so that every hardware
+//             thread gets a share
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::forkLevels(){
+
+    int levels = 0;
+    for (unsigned threads = thread::hardware_concurrency(); threads > 1; threads = (threads + 1) / 2)
+        levels++;
+    return levels;
+}
+
+//Description: Union of two subtrees the BST owns. ours is split around the root
+//             of theirs; on equal elements ours is kept and theirs left out.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::unionNodes(BSTNode<ElementType>* ours, BSTNode<ElementType>* theirs, vector<BSTNode<ElementType>*>& leftOut, int forks){
+
+    if (ours == NULL)
+        return theirs;
+    if (theirs == NULL)
+        return ours;
+
+    BSTNode<ElementType>* less;
+    BSTNode<ElementType>* greater;
+    BSTNode<ElementType>* middle = split(ours, theirs->element, less, greater);
+    BSTNode<ElementType>* theirsLeft = theirs->left;
+    BSTNode<ElementType>* theirsRight = theirs->right;
+    if (middle == NULL) {
+        middle = theirs;
     } else {
-        removeR(current->left, target);
+        theirs->left = NULL;
+        theirs->right = NULL;
+        theirs->size = 1;
+        leftOut.push_back(theirs);
     }
-}
\ No newline at end of file
+
+    bool parallel = forks > 0 && (less != NULL ? less->size : 0) + (greater != NULL ? greater->size : 0) >= PARALLEL_GRAIN;
+    vector<BSTNode<ElementType>*> rightLeftOut;
+    forkJoin(parallel,
+             [&] { less = unionNodes(less, theirsLeft, leftOut, forks - 1); },
+             [&] { greater = unionNodes(greater, theirsRight, rightLeftOut, forks - 1); });
+    leftOut.insert(leftOut.end(), rightLeftOut.begin(), rightLeftOut.end());
+    return join(less, middle, greater);
+}
+
+//Description: Keeps the nodes of ours whose element is among the theirCount sorted
+//             elements of theirs. theirs is split at its middle element, so the
+//             recursion stays O(log2 m) deep whatever the shape of the other tree.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::intersectNodes(BSTNode<ElementType>* ours, const ElementType* const* theirs, int theirCount, vector<BSTNode<ElementType>*>& leftOut, int forks){
+
+    if (ours == NULL)
+        return NULL;
+    if (theirCount == 0) {
+        leftOut.push_back(ours);
+        return NULL;
+    }
+
+    int half = theirCount / 2;
+    BSTNode<ElementType>* less;
+    BSTNode<ElementType>* greater;
+    BSTNode<ElementType>* middle = split(ours, *theirs[half], less, greater);
+
+    bool parallel = forks > 0 && (less != NULL ? less->size : 0) + (greater != NULL ? greater->size : 0) >= PARALLEL_GRAIN;
+    vector<BSTNode<ElementType>*> rightLeftOut;
+    forkJoin(parallel,
+             [&] { less = intersectNodes(less, theirs, half, leftOut, forks - 1); },
+             [&] { greater = intersectNodes(greater, theirs + half + 1, theirCount - half - 1, rightLeftOut, forks - 1); });
+    leftOut.insert(leftOut.end(), rightLeftOut.begin(), rightLeftOut.end());
+    return (middle == NULL) ? joinTrees(less, greater) : join(less, middle, greater);
+}
+
+//Description: Keeps the nodes of ours whose element is not among the theirCount
+//             sorted elements of theirs
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+BSTNode<ElementType>* BST<ElementType, BalancePolicy, NodeAllocator>::differenceNodes(BSTNode<ElementType>* ours, const ElementType* const* theirs, int theirCount, vector<BSTNode<ElementType>*>& leftOut, int forks){
+
+    if (ours == NULL || theirCount == 0)
+        return ours;
+
+    int half = theirCount / 2;
+    BSTNode<ElementType>* less;
+    BSTNode<ElementType>* greater;
+    BSTNode<ElementType>* middle = split(ours, *theirs[half], less, greater);
+    if (middle != NULL)
+        leftOut.push_back(middle);
+
+    bool parallel = forks > 0 && (less != NULL ? less->size : 0) + (greater != NULL ? greater->size : 0) >= PARALLEL_GRAIN;
+    vector<BSTNode<ElementType>*> rightLeftOut;
+    forkJoin(parallel,
+             [&] { less = differenceNodes(less, theirs, half, leftOut, forks - 1); },
+             [&] { greater = differenceNodes(greater, theirs + half + 1, theirCount - half - 1, rightLeftOut, forks - 1); });
+    leftOut.insert(leftOut.end(), rightLeftOut.begin(), rightLeftOut.end());
+    return joinTrees(less, greater);
+}
+
+//Description: Collects pointers to the elements of other, in order, so that the
+//             set operations can split them at any index
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+vector<const ElementType*> BST<ElementType, BalancePolicy, NodeAllocator>::sortedElements(const BST& other){
+
+    vector<const ElementType*> elements;
+    elements.reserve(other.nodesCount());
+    for (iterator it = other.begin(); it != other.end(); ++it)
+        elements.push_back(&*it);
+    return elements;
+}
+
+//Description: Destroys the subtrees left out by a set operation and recounts the
+//             elements. Returns the number of nodes destroyed.
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::discard(vector<BSTNode<ElementType>*>& leftOut){
+
+    int discarded = 0;
+    for (size_t i = 0; i < leftOut.size(); i++) {
+        discarded += leftOut[i]->size;
+        deleteNodes(leftOut[i]);
+    }
+    leftOut.clear();
+    elementCount = nodesCount();
+    return discarded;
+}
+
+// Description: Adds a copy of every element of other missing from the BST
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::unionWith(const BST& other, vector<ElementType>* duplicates){
+
+    // The nodes are copied first, in one O(m) balanced build, so that the
+    // parallel part only relinks nodes and never calls the allocator
+    iterator next = other.begin();
+    BSTNode<ElementType>* theirs = buildBalanced(next, other.nodesCount());
+
+    vector<BSTNode<ElementType>*> leftOut;
+    root = unionNodes(root, theirs, leftOut, forkLevels());
+    if (duplicates != NULL) {
+        for (size_t i = 0; i < leftOut.size(); i++)
+            duplicates->push_back(std::move(leftOut[i]->element));
+    }
+    return discard(leftOut);
+}
+
+// Description: Removes every element not in other
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::intersectWith(const BST& other){
+
+    if (&other == this)
+        return 0;
+    vector<const ElementType*> theirs = sortedElements(other);
+    vector<BSTNode<ElementType>*> leftOut;
+    root = intersectNodes(root, theirs.data(), (int) theirs.size(), leftOut, forkLevels());
+    return discard(leftOut);
+}
+
+// Description: Removes every element also in other
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+int BST<ElementType, BalancePolicy, NodeAllocator>::difference(const BST& other){
+
+    vector<BSTNode<ElementType>*> leftOut;
+    if (&other == this) {
+        if (root != NULL)
+            leftOut.push_back(root);
+        root = NULL;
+    } else {
+        vector<const ElementType*> theirs = sortedElements(other);
+        root = differenceNodes(root, theirs.data(), (int) theirs.size(), leftOut, forkLevels());
+    }
+    return discard(leftOut);
+}
+
+// Description: Removes every element not less than low and less than high
+template <class ElementType, class BalancePolicy, class NodeAllocator>
+template <class Key>
+int BST<ElementType, BalancePolicy, NodeAllocator>::eraseRange(const Key& low, const Key& high){
+
+    BSTNode<ElementType>* less;
+    BSTNode<ElementType>* notLess;
+    BSTNode<ElementType>* inRange;
+    BSTNode<ElementType>* greater;
+    splitLess(root, low, less, notLess);
+    splitLess(notLess, high, inRange, greater);
+    root = joinTrees(less, greater);
+
+    vector<BSTNode<ElementType>*> leftOut;
+    if (inRange != NULL)
+        leftOut.push_back(inRange);
+    return discard(leftOut);
+}
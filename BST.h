@@ -4,7 +4,8 @@
  * Description: Data collection Binary Search Tree ADT class.
  *              Link-based implementation.
  *
- * Class invariant: It is always a BST.
+ * Class invariant: It is always a BST, and every node's size is the number of
+ *                  nodes in its subtree.
  * 
  * Author: Inspired from our textbook
  * Date of last modification: July 2017
@@ -12,51 +13,170 @@
 
 #pragma once
 
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "BSTNode.h"
+#include "BSTIterator.h"
+#include "Traversal.h"
+#include "BalancePolicy.h"
+#include "NodeAllocator.h"
+#include "FrozenBST.h"
+#include "BSTStats.h"
 #include "ElementAlreadyExistsInBSTException.h"
 #include "ElementDoesNotExistInBSTException.h"
 
 
-template <class ElementType>
+// BalancePolicy: UnbalancedPolicy (default), AVLPolicy, SplayPolicy or
+//                SemiSplayPolicy, see BalancePolicy.h
+// NodeAllocator: BSTNodePool (default) or NewDeleteAllocator, see NodeAllocator.h
+template <class ElementType, class BalancePolicy = UnbalancedPolicy,
+          class NodeAllocator = BSTNodePool<ElementType> >
 class BST {
 	
 private:
 
-	BSTNode<ElementType>* root; 
+	mutable BSTNode<ElementType>* root;  // mutable: a splaying policy restructures the tree on lookups
     int elementCount;           
+    NodeAllocator allocator;    // Storage of every node in the tree
 
-    //Description: Helper for insert
-    bool insertR(const ElementType& element, BSTNode<ElementType>* current) ; // throw(ElementAlreadyExistsException);
+    // Links visited by the descent of an insert or a remove, see BSTNode.h
+    typedef BSTPath<ElementType> Path;
 
-    //Description: Helper for retrieve
-    ElementType& retrieveR(const ElementType& targetElement, BSTNode<ElementType>* current) const throw(ElementDoesNotExistInBSTException);
+#ifdef BST_ENABLE_STATS
+    mutable BSTCounters counters;   // Also updated by const lookups, see BSTStats.h
+    int descentDepth;               // Nodes compared by the last findLink
+#endif
 
-    //Description: Helper for traversInOrder
-    void traverseInOrderR(void visit(ElementType&), BSTNode<ElementType>* current) const;
+    //Description: Descends towards target and returns the link that holds it,
+    //             or the empty link where it would be inserted. The links visited
+    //             on the way down are stored in path.
+    BSTNode<ElementType>** findLink(const ElementType& target, Path& path);
 
-    //Description: Helper for copy (basically preOrderTraverse)
-    void copyR(BSTNode<ElementType>* current);
+    //Description: Returns the node holding an element equal to key, NULL if there is none
+    template <class Key>
+    BSTNode<ElementType>* findNode(const Key& key) const;
 
-    //Description: Helper for destructor (basically postOrderTraversal)
-    void deleteR(BSTNode<ElementType>*& current);
+    // Lookups advanced together by retrieveBatch
+    static const int BATCH_WIDTH = 16;
 
-	int countR(BSTNode<ElementType>* current) const;
+    //Description: Rebalances the nodes held by the recorded links, bottom-up
+    void rebalancePath(Path& path);
 
-    int duplicateR(BSTNode<ElementType>* current, const ElementType& target) const;
+    //Description: Adds delta to the subtree size of every node held by the
+    //             recorded links, after an insert or before a remove
+    void resizeAncestors(Path& path, int delta);
 
-	ElementType& minR(BSTNode<ElementType>* current) const;
+    //Description: Builds a node in storage obtained from the allocator, passing
+    //             args on to the constructor of its element
+    template <class... Args>
+    BSTNode<ElementType>* createNode(Args&&... args);
 
-	ElementType& maxR(BSTNode<ElementType>* current) const;
+    //Description: Helper for both inserts, copies or moves newElement into a new node
+    template <class Element>
+    void insertElement(Element&& newElement); // throw(ElementAlreadyExistsInBSTException);
 
-    void removeR(BSTNode<ElementType>*& current, const ElementType& target);
+    //Description: Helper for the inserts of a splaying policy, makes newNode the
+    //             root above the old one, just splayed next to it. order is the
+    //             order of the old root relative to newNode, as SearchKey::compare.
+    void linkAtRoot(BSTNode<ElementType>* newNode, int order);
+
+    //Description: Destroys a node and gives its storage back to the allocator
+    void destroyNode(BSTNode<ElementType>* node);
+
+    //Description: Helper for copy, clones a subtree node for node and returns
+    //             the root of the clone
+    BSTNode<ElementType>* cloneNodes(const BSTNode<ElementType>* source);
+
+    //Description: Helper for destructor, frees a subtree with O(1) extra space
+    void deleteNodes(BSTNode<ElementType>*& current);
+
+    //Description: Helper for destructor and move assignment, destroys every node
+    //             that cannot be left to the allocator
+    void releaseNodes() noexcept;
+
+    //Description: Helper for buildFromSorted, links the next count elements into
+    //             a height-optimal subtree and returns its root
+    template <class ForwardIterator>
+    BSTNode<ElementType>* buildBalanced(ForwardIterator& next, int count);
+
+    // Split/join primitives of the set operations. They relink existing nodes
+    // and keep sizes (and heights for a rebalancing policy) up to date; with
+    // AVLPolicy their cost is proportional to the difference in height of the
+    // trees involved. split and detachMax descend through a Path, like insert
+    // and remove, so a degenerate tree costs them O(n) time but no stack. Each
+    // BST owns the storage of its nodes, so nodes never move from one BST to
+    // another and these stay private.
+
+    // Set operations on subtrees of at least PARALLEL_GRAIN nodes run their two
+    // halves on two threads
+    static const int PARALLEL_GRAIN = 4096;
+
+    //Description: Links middle between left and right, all of left being less than
+    //             middle and all of right greater, and returns the root
+    static BSTNode<ElementType>* join(BSTNode<ElementType>* left, BSTNode<ElementType>* middle, BSTNode<ElementType>* right);
+
+    //Description: Same as join, without a middle node
+    static BSTNode<ElementType>* joinTrees(BSTNode<ElementType>* left, BSTNode<ElementType>* right);
+
+    //Description: Unlinks the largest node of a non-empty subtree and returns it
+    static BSTNode<ElementType>* detachMax(BSTNode<ElementType>*& subtree);
+
+    //Description: Splits subtree into the nodes less than key and the nodes greater,
+    //             and returns the node equal to key, unlinked (NULL if none)
+    template <class Key>
+    static BSTNode<ElementType>* split(BSTNode<ElementType>* subtree, const Key& key, BSTNode<ElementType>*& less, BSTNode<ElementType>*& greater);
+
+    //Description: Splits subtree into the nodes less than key and the others
+    template <class Key>
+    static void splitLess(BSTNode<ElementType>* subtree, const Key& key, BSTNode<ElementType>*& less, BSTNode<ElementType>*& notLess);
+
+    //Description: Runs leftTask and rightTask, on two threads when parallel
+    template <class LeftTask, class RightTask>
+    static void forkJoin(bool parallel, LeftTask&& leftTask, RightTask&& rightTask);
+
+    //Description: Number of times a set operation forks, so that every hardware
+    //             thread gets a share
+    static int forkLevels();
+
+    //Description: Helpers for the set operations. ours is consumed and the result
+    //             returned; the roots of the subtrees left out are appended to leftOut.
+    //             intersectNodes and differenceNodes take the theirCount elements of
+    //             the other tree in order, and split them at the middle one.
+    static BSTNode<ElementType>* unionNodes(BSTNode<ElementType>* ours, BSTNode<ElementType>* theirs, vector<BSTNode<ElementType>*>& leftOut, int forks);
+    static BSTNode<ElementType>* intersectNodes(BSTNode<ElementType>* ours, const ElementType* const* theirs, int theirCount, vector<BSTNode<ElementType>*>& leftOut, int forks);
+    static BSTNode<ElementType>* differenceNodes(BSTNode<ElementType>* ours, const ElementType* const* theirs, int theirCount, vector<BSTNode<ElementType>*>& leftOut, int forks);
+
+    //Description: Pointers to the elements of other, in order
+    static vector<const ElementType*> sortedElements(const BST& other);
+
+    //Description: Destroys the subtrees left out by a set operation and recounts the elements
+    int discard(vector<BSTNode<ElementType>*>& leftOut);
 
 public:
 
+    // Walks the elements in order, see BSTIterator.h
+    typedef BSTIterator<ElementType> iterator;
+
     // Constructors and destructor:
 	BST();                               // Default constructor
     BST(ElementType& element);           // Parameterized constructor 
-	BST(const BST<ElementType>& aBST);   // Copy constructor 
+	BST(const BST& aBST);                // Copy constructor 
+	BST(BST&& aBST) noexcept;            // Move constructor
     ~BST();                              // Destructor 
+
+    // Description: A copy has the shape of the original, node for node, in one
+    //              block of the pool. Moving hands the nodes over and leaves the
+    //              BST moved from empty.
+	// Time efficiency: O(n) and no comparisons to copy, O(1) to move
+    BST& operator=(const BST& aBST);
+    BST& operator=(BST&& aBST) noexcept;
 	
     // BST operations:
 
@@ -68,24 +188,195 @@ public:
 	// Time efficiency: O(log2 n)
     // Pre Condition: Element not already in BST
     // Post Condition: BST is still a Binary Search Tree and element count incrememented by 1
-	void insert(const ElementType& newElement) throw(ElementAlreadyExistsInBSTException);	
+	void insert(const ElementType& newElement); // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Same as insert above, but moves newElement into the BST.
+    //              newElement is left untouched when the exception is thrown.
+	void insert(ElementType&& newElement); // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Builds a new element in place from the constructor arguments
+    //              of ElementType and inserts it into the BST
+	// Time efficiency: O(log2 n)
+    // Pre Condition: Element not already in BST
+    // Post Condition: BST is still a Binary Search Tree and element count incrememented by 1
+	template <class... Args>
+	ElementType& emplace(Args&&... args); // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Replaces the content of the BST with the elements of [first, last),
+    //              linked directly into a tree of minimal height. Dereferencing
+    //              a move_iterator moves the elements in instead of copying them.
+	// Time efficiency: O(n), no comparisons
+    // Pre Condition: [first, last) is sorted and holds no duplicates
+	template <class ForwardIterator>
+	void buildFromSorted(ForwardIterator first, ForwardIterator last);
+
+    // Description: Same as buildFromSorted, but sorts [first, last) first. Of several
+    //              equal elements the first one is kept, the others are appended
+    //              to duplicates (when given) in a single pass.
+    //              Returns the number of duplicates left out.
+	// Time efficiency: O(n log2 n)
+	template <class InputIterator>
+	int buildFromUnsorted(InputIterator first, InputIterator last, vector<ElementType>* duplicates = NULL);
 
-    // Description: Retrieves a target element from the BST
+    // Description: Retrieves a target element from the BST. With a splaying
+    //              policy, retrieve, find and contains move it towards the root.
 	// Time efficiency: O(log2 n)
-	ElementType& retrieve(const ElementType& targetElement) const throw(ElementDoesNotExistInBSTException);
+	ElementType& retrieve(const ElementType& targetElement) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns a pointer to the element equal to key, NULL if there is
+    //              none. Never throws, so misses cost no more than hits.
+    //              Key is either ElementType or any type ElementType can be compared
+    //              with through == and < (e.g. a string_view for WordPair), so a
+    //              lookup does not need to build an element.
+	// Time efficiency: O(log2 n)
+	template <class Key>
+	ElementType* find(const Key& key) const;
+
+    // Description: Returns true if an element equal to key is in the BST
+	// Time efficiency: O(log2 n)
+	template <class Key>
+	bool contains(const Key& key) const;
+
+    // Description: Looks up every key of keys at once. results[i] is set to the
+    //              element equal to keys[i], or NULL if there is none, and the
+    //              number of hits is returned. Never throws.
+    //              Up to BATCH_WIDTH descents advance in lockstep, one level each
+    //              in turn, and the next node of each one is prefetched while the
+    //              others are compared, so their cache misses overlap instead of
+    //              following one another.
+	// Time efficiency: O(k log2 n) for k keys
+	template <class Key>
+	int retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results) const;
 
     // Description: traverse the BST in order and "visit" each element
 	// Time efficiency: O(n)
 	void traverseInOrder(void visit(ElementType&)) const;
 
+    // Description: Same as traverseInOrder above, for visitors that carry state
+    //              (any object callable with an ElementType&)
+	// Time efficiency: O(n)
+	template <class Visitor>
+	void traverseInOrder(Visitor& visitor) const;
+
+    // Description: Visits the elements in PRE_ORDER, IN_ORDER or POST_ORDER with any
+    //              callable taking an ElementType& (lambda, functor or function),
+    //              which the compiler can inline. If it returns bool, returning
+    //              false stops the traversal. Returns false if it was stopped.
+	// Time efficiency: O(n), O(height) extra space
+	template <class Visitor>
+	bool traverse(Visitor&& visitor, TraversalOrder order = IN_ORDER) const;
+
+    // Description: Iterators to the smallest element and past the largest one.
+    //              Iterators are invalidated by insert and remove and, with a
+    //              splaying policy, by retrieve, find and contains as well.
+	// Time efficiency: O(log2 n)
+	iterator begin() const;
+	iterator end() const;
+
+    // Description: Returns an iterator to the first element not less than key
+    //              (end() if there is none). Key is ElementType or any type it
+    //              compares with through == and <, as for find. It does not splay,
+    //              and its iterator is invalidated as those of begin().
+	// Time efficiency: O(log2 n), so visiting the k elements of a range is O(log2 n + k)
+	template <class Key>
+	iterator lower_bound(const Key& key) const;
+
+    // Description: Returns an iterator to the first element greater than key
+	// Time efficiency: O(log2 n)
+	template <class Key>
+	iterator upper_bound(const Key& key) const;
+
+    // Description: Returns the range of elements equal to key, {lower_bound, upper_bound}.
+    //              With a key that several elements equal, such as a WordPrefix
+    //              for WordPair, this is every element matching it.
+	// Time efficiency: O(log2 n)
+	template <class Key>
+	pair<iterator, iterator> equal_range(const Key& key) const;
+
+    // Description: Returns an immutable copy of the BST laid out for fast searches,
+    //              see FrozenBST.h. Later changes to the BST do not affect it.
+	// Time efficiency: O(n)
+	FrozenBST<ElementType> freeze() const;
+
+    // Description: Returns the number of nodes, read from the subtree size of the
+    //              root that insert and remove keep up to date in every node
+    // Time efficiency: O(1)
 	int nodesCount() const;
 
+    // Description: Returns the number of nodes on the longest root-to-leaf path (0 when empty)
+    // Time efficiency: O(n)
+    int height() const;
+
+    // Description: Reports the shape of the BST and the memory its nodes use, and,
+    //              in builds with BST_ENABLE_STATS, the comparisons made per insert,
+    //              retrieve and remove, the nodes allocated and freed and the depth
+    //              reached by those operations. See BSTStats.h.
+    // Time efficiency: O(n), O(height) extra space
+    BSTStats stats() const;
+
 	ElementType& min() const;
 	ElementType& max() const;
 
+    // Description: Returns the number of copies of targetElement, 0 or 1 since
+    //              the BST holds no duplicates
+    // Time efficiency: O(log2 n)
     int duplicate(const ElementType& targetElement) const;
 
-	void remove(const ElementType& targetElement) throw(ElementDoesNotExistInBSTException);
+    // Order statistics, all answered from the subtree sizes on a single descent.
+    // Indexes count from 0 in sorted order.
+
+    // Description: Returns the number of elements less than key
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    int rank(const Key& key) const;
+
+    // Description: Returns the element at index in sorted order
+    // Time efficiency: O(log2 n)
+    ElementType& select(int index) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns the element at index (n - 1) / 2 in sorted order
+    // Time efficiency: O(log2 n)
+    ElementType& median() const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns the number of elements not less than low and less than high
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    int countRange(const Key& low, const Key& high) const;
+
+    // Description: Returns an iterator to the element at index, end() if there is
+    //              none. A page of k elements starting at index costs O(log2 n + k).
+    // Time efficiency: O(log2 n)
+    iterator nth(int index) const;
+
+	void remove(const ElementType& targetElement); // throw(ElementDoesNotExistInBSTException);
+
+    // Bulk set operations. Instead of one insert or remove per element, the BST
+    // is split around the elements of the other tree and joined back, with the
+    // two halves of large subtrees processed in parallel. Only with AVLPolicy
+    // do they cost O(m log2(n / m + 1)) work for trees of m and n elements,
+    // m <= n: with the other policies each split costs the height of the BST,
+    // up to O(n), for O(m n) in the worst case. Their recursion follows a
+    // balanced view of the other tree and is O(log2 m) deep for every policy.
+    // The other BST must not change while they run.
+
+    // Description: Adds a copy of every element of other missing from the BST. Of
+    //              two equal elements the one already in the BST is kept and the
+    //              other is appended to duplicates (when given), so merging a new
+    //              release throws no exception per known word.
+    //              Returns the number of duplicates left out.
+    int unionWith(const BST& other, vector<ElementType>* duplicates = NULL);
+
+    // Description: Removes every element not in other, returns the number removed
+    int intersectWith(const BST& other);
+
+    // Description: Removes every element also in other, returns the number removed
+    int difference(const BST& other);
+
+    // Description: Removes every element not less than low and less than high,
+    //              returns the number removed
+	// Time efficiency: O(log2 n + k) for k elements removed
+    template <class Key>
+    int eraseRange(const Key& low, const Key& high);
 	
 }; // end BST
 
@@ -0,0 +1,384 @@
+/*
+ * BSTBench.cpp
+ *
+ * Description: Micro-benchmarks of the BST, with each of its balance policies and
+ *              with its node pool or one new/delete per node (BST<AVL,new>), next
+ *              to the BTree, std::map and std::unordered_map fed the same keys.
+ *              For every container, workload and size, reports the time and the
+ *              key comparisons per insert, retrieve (hit and miss), in-order
+ *              traversal, copy, destruction and remove, and the peak resident
+ *              set size. FrozenBST, read-only, reports the freeze of an AVL tree
+ *              holding the keys, its lookups and its traversal.
+ *
+ *              Workloads:
+ *                sorted  - keys inserted, retrieved and removed in increasing order
+ *                random  - keys inserted and removed in random order, retrieved uniformly
+ *                zipfian - keys inserted and removed in random order, retrieved
+ *                          with Zipfian skew (a few hot keys take most lookups)
+ *
+ *              Usage: bst_bench [--max-keys N] [--seed S] [--only CONTAINER]
+ *
+ *              Sizes go from 1K keys up to --max-keys (default 1M, at most 10M).
+ *              Every case runs in its own child process, so its peak RSS is
+ *              measured alone and one case cannot warm the heap for the next.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "BST.h"
+#include "BTree.h"
+
+using namespace std;
+
+
+// Key comparisons made since the last reset, counted by CountedKey
+static unsigned long comparisons = 0;
+
+// Integer key counting every comparison made on it. It offers a three-way
+// compare, so a BST descent pays one comparison per level as it does for WordPair.
+class CountedKey {
+
+private:
+	uint64_t value;
+
+public:
+	CountedKey() : value(0) {}
+	explicit CountedKey(uint64_t value) : value(value) {}
+
+	uint64_t getValue() const { return value; }
+
+	bool operator==(const CountedKey& rhs) const { comparisons++; return value == rhs.value; }
+	bool operator<(const CountedKey& rhs) const { comparisons++; return value < rhs.value; }
+	int compare(const CountedKey& rhs) const {
+		comparisons++;
+		return (value < rhs.value) ? -1 : (value > rhs.value);
+	}
+};
+
+struct CountedKeyHash {
+	size_t operator()(const CountedKey& key) const { return hash<uint64_t>()(key.getValue()); }
+};
+
+
+// Operations of the library trees (BST and BTree share their interface)
+template <class Tree>
+struct TreeOps {
+	static void insert(Tree& tree, const CountedKey& key) { tree.insert(key); }
+	static bool retrieve(const Tree& tree, const CountedKey& key) { return tree.find(key) != NULL; }
+	static void remove(Tree& tree, const CountedKey& key) { tree.remove(key); }
+	static uint64_t traverse(const Tree& tree) {
+		uint64_t sum = 0;
+		tree.traverse([&sum](const CountedKey& key) { sum += key.getValue(); });
+		return sum;
+	}
+};
+
+// Operations of the standard maps, each key mapped to its value
+template <class Map>
+struct MapOps {
+	static void insert(Map& map, const CountedKey& key) { map.emplace(key, key.getValue()); }
+	static bool retrieve(const Map& map, const CountedKey& key) { return map.find(key) != map.end(); }
+	static void remove(Map& map, const CountedKey& key) { map.erase(key); }
+	static uint64_t traverse(const Map& map) {
+		uint64_t sum = 0;
+		for (const auto& entry : map)
+			sum += entry.first.getValue();
+		return sum;
+	}
+};
+
+
+// Keys of one case: present keys are even, so odd ones always miss
+struct Workload {
+	vector<CountedKey> inserts;    // Every key once, in insertion order
+	vector<CountedKey> hits;       // n lookups of present keys
+	vector<CountedKey> misses;     // n lookups of absent keys
+	vector<CountedKey> removals;   // Every key once, in removal order
+};
+
+// Zipfian ranks in [0, n) with skew theta, the generator of Gray et al.
+// ("Quickly Generating Billion-Record Synthetic Databases") used by YCSB
+class ZipfianGenerator {
+
+private:
+	uint64_t n;
+	double theta;
+	double alpha;
+	double zetaN;
+	double eta;
+
+	static double zeta(uint64_t n, double theta) {
+		double sum = 0;
+		for (uint64_t i = 1; i <= n; i++)
+			sum += 1 / pow((double) i, theta);
+		return sum;
+	}
+
+public:
+	ZipfianGenerator(uint64_t n, double theta = 0.99) : n(n), theta(theta) {
+		alpha = 1 / (1 - theta);
+		zetaN = zeta(n, theta);
+		eta = (1 - pow(2.0 / n, 1 - theta)) / (1 - zeta(2, theta) / zetaN);
+	}
+
+	template <class Engine>
+	uint64_t operator()(Engine& engine) {
+		double u = uniform_real_distribution<double>(0, 1)(engine);
+		double uz = u * zetaN;
+		if (uz < 1)
+			return 0;
+		if (uz < 1 + pow(0.5, theta))
+			return 1;
+		return min(n - 1, (uint64_t) (n * pow(eta * u - eta + 1, alpha)));
+	}
+};
+
+Workload makeWorkload(const string& name, size_t n, uint64_t seed) {
+	mt19937_64 engine(seed);
+	Workload workload;
+	vector<CountedKey> keys;
+	keys.reserve(n);
+	for (size_t i = 0; i < n; i++)
+		keys.push_back(CountedKey(2 * i + 2));
+
+	workload.misses.reserve(n);
+	if (name == "sorted") {
+		workload.inserts = keys;
+		workload.hits = keys;
+		workload.removals = keys;
+		for (size_t i = 0; i < n; i++)
+			workload.misses.push_back(CountedKey(2 * i + 1));
+		return workload;
+	}
+
+	workload.inserts = keys;
+	shuffle(workload.inserts.begin(), workload.inserts.end(), engine);
+	workload.removals = keys;
+	shuffle(workload.removals.begin(), workload.removals.end(), engine);
+	uniform_int_distribution<size_t> anyIndex(0, n - 1);
+	for (size_t i = 0; i < n; i++)
+		workload.misses.push_back(CountedKey(2 * anyIndex(engine) + 1));
+
+	workload.hits.reserve(n);
+	if (name == "random") {
+		for (size_t i = 0; i < n; i++)
+			workload.hits.push_back(keys[anyIndex(engine)]);
+	}
+	else {
+		// Rank r is the r-th hottest key. The ranking is shuffled apart from the
+		// insertion order: the hot keys are scattered across the tree instead of
+		// grouped at one end, and are not the first inserted either, which an
+		// unbalanced tree would keep next to its root.
+		vector<CountedKey> ranking = keys;
+		shuffle(ranking.begin(), ranking.end(), engine);
+		ZipfianGenerator zipfian(n);
+		for (size_t i = 0; i < n; i++)
+			workload.hits.push_back(ranking[zipfian(engine)]);
+	}
+	return workload;
+}
+
+
+// Description of the case being run, printed at the start of every result line
+static string caseLabel;
+
+// Prevents the compiler from dropping the work of a measured loop
+static volatile uint64_t sink;
+
+// Times body, which performs operationCount operations, and prints its line
+void measure(const string& operation, size_t operationCount, const function<void()>& body) {
+	comparisons = 0;
+	auto start = chrono::steady_clock::now();
+	body();
+	auto elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+	cout << caseLabel << left << setw(15) << operation << right
+	     << setw(12) << fixed << setprecision(1) << elapsed / operationCount
+	     << setw(10) << setprecision(2) << (double) comparisons / operationCount << '\n';
+}
+
+template <class Container, class Ops>
+void runCase(const Workload& workload) {
+	size_t n = workload.inserts.size();
+	Container* container = new Container();
+
+	measure("insert", n, [&]() {
+		for (const CountedKey& key : workload.inserts)
+			Ops::insert(*container, key);
+	});
+	measure("retrieve hit", n, [&]() {
+		size_t found = 0;
+		for (const CountedKey& key : workload.hits)
+			found += Ops::retrieve(*container, key);
+		sink = found;
+	});
+	measure("retrieve miss", n, [&]() {
+		size_t found = 0;
+		for (const CountedKey& key : workload.misses)
+			found += Ops::retrieve(*container, key);
+		sink = found;
+	});
+	measure("traverse", n, [&]() {
+		sink = Ops::traverse(*container);
+	});
+	Container* copy = NULL;
+	measure("copy", n, [&]() {
+		copy = new Container(*container);
+	});
+	measure("destroy", n, [&]() {
+		delete copy;
+	});
+	measure("remove", n, [&]() {
+		for (const CountedKey& key : workload.removals)
+			Ops::remove(*container, key);
+	});
+	delete container;
+}
+
+// Sum of the keys visited by the traversal of a FrozenBST, which takes a plain function
+static uint64_t frozenSum;
+
+void addToFrozenSum(const CountedKey& key) {
+	frozenSum += key.getValue();
+}
+
+// Read-only case of the snapshot BST::freeze() takes of an AVL tree holding the
+// keys: the lookups and traversal compare with those of the live BST<AVL>
+void runFrozenCase(const Workload& workload) {
+	size_t n = workload.inserts.size();
+	BST<CountedKey, AVLPolicy>* tree = new BST<CountedKey, AVLPolicy>();
+	for (const CountedKey& key : workload.inserts)
+		tree->insert(key);
+	FrozenBST<CountedKey> frozen;
+	measure("freeze", n, [&]() {
+		frozen = tree->freeze();
+	});
+	delete tree;
+
+	measure("retrieve hit", n, [&]() {
+		size_t found = 0;
+		for (const CountedKey& key : workload.hits)
+			found += frozen.find(key) != NULL;
+		sink = found;
+	});
+	measure("retrieve miss", n, [&]() {
+		size_t found = 0;
+		for (const CountedKey& key : workload.misses)
+			found += frozen.find(key) != NULL;
+		sink = found;
+	});
+	measure("traverse", n, [&]() {
+		frozenSum = 0;
+		frozen.traverseInOrder(addToFrozenSum);
+		sink = frozenSum;
+	});
+}
+
+
+typedef BST<CountedKey> UnbalancedBST;
+typedef BST<CountedKey, AVLPolicy> AVLBST;
+typedef BST<CountedKey, AVLPolicy, NewDeleteAllocator<CountedKey> > NewDeleteAVLBST;
+typedef BST<CountedKey, SplayPolicy> SplayBST;
+typedef BST<CountedKey, SemiSplayPolicy> SemiSplayBST;
+typedef BTree<CountedKey> KeyBTree;
+typedef map<CountedKey, uint64_t> OrderedMap;
+typedef unordered_map<CountedKey, uint64_t, CountedKeyHash> HashMap;
+
+struct Contender {
+	const char* name;
+	void (*run)(const Workload&);
+	size_t maxSortedKeys;          // Sorted input degenerates an unbalanced tree into a list
+};
+
+const Contender contenders[] = {
+	{ "BST",           runCase<UnbalancedBST, TreeOps<UnbalancedBST> >, 10000 },
+	{ "BST<AVL>",      runCase<AVLBST, TreeOps<AVLBST> >,               SIZE_MAX },
+	{ "FrozenBST",     runFrozenCase,                                   SIZE_MAX },
+	{ "BST<AVL,new>",  runCase<NewDeleteAVLBST, TreeOps<NewDeleteAVLBST> >, SIZE_MAX },
+	{ "BST<Splay>",    runCase<SplayBST, TreeOps<SplayBST> >,           SIZE_MAX },
+	{ "BST<SemiSplay>", runCase<SemiSplayBST, TreeOps<SemiSplayBST> >,  SIZE_MAX },
+	{ "BTree",         runCase<KeyBTree, TreeOps<KeyBTree> >,           SIZE_MAX },
+	{ "map",           runCase<OrderedMap, MapOps<OrderedMap> >,        SIZE_MAX },
+	{ "unordered_map", runCase<HashMap, MapOps<HashMap> >,              SIZE_MAX },
+};
+
+const char* workloadNames[] = { "sorted", "random", "zipfian" };
+
+// Runs one case in a child process and prints its peak RSS
+void runIsolated(const Contender& contender, const string& workloadName, size_t n, uint64_t seed) {
+	ostringstream label;
+	label << left << setw(15) << contender.name << setw(9) << workloadName << right << setw(10) << n << "  ";
+
+	if (workloadName == "sorted" && n > contender.maxSortedKeys) {
+		cout << label.str() << "skipped (a sorted insert is O(n) per key)" << endl;
+		return;
+	}
+
+	cout.flush();
+	pid_t child = fork();
+	if (child == 0) {
+		caseLabel = label.str();
+		Workload workload = makeWorkload(workloadName, n, seed);
+		contender.run(workload);
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		cout << caseLabel << left << setw(15) << "peak RSS" << right
+		     << setw(9) << usage.ru_maxrss / 1024 << " MiB" << endl;
+		_exit(0);
+	}
+
+	int status = 0;
+	if (child < 0 || waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		cout << label.str() << "failed" << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+
+	size_t maxKeys = 1000000;
+	uint64_t seed = 42;
+	string only = "";
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--max-keys") == 0 && i + 1 < argc)
+			maxKeys = min((size_t) strtoull(argv[++i], NULL, 10), (size_t) 10000000);
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--only") == 0 && i + 1 < argc)
+			only = argv[++i];
+		else {
+			cout << "Usage: " << argv[0] << " [--max-keys N] [--seed S] [--only CONTAINER]" << endl;
+			return 1;
+		}
+	}
+
+	cout << left << setw(15) << "container" << setw(9) << "workload" << right << setw(10) << "keys" << "  "
+	     << left << setw(15) << "operation" << right << setw(12) << "ns/op" << setw(10) << "cmp/op" << endl;
+
+	for (const Contender& contender : contenders) {
+		if (!only.empty() && only != contender.name)
+			continue;
+		for (const char* workloadName : workloadNames)
+			for (size_t n = 1000; n <= maxKeys; n *= 10)
+				runIsolated(contender, workloadName, n, seed);
+	}
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * BSTIterator.cpp
+ *
+ * Description: Bidirectional in-order iterator over a BST.
+ *
+ * Class invariant: path is empty (end) or runs from the root to the current node.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "BSTIterator.h"
+
+// Not attached to any BST
+template <class ElementType>
+BSTIterator<ElementType>::BSTIterator() {
+    root = NULL;
+}
+
+// End of the BST rooted at root
+template <class ElementType>
+BSTIterator<ElementType>::BSTIterator(BSTNode<ElementType>* root) {
+    this->root = root;
+}
+
+//Description: Extends the path from node down to the smallest element below it
+template <class ElementType>
+void BSTIterator<ElementType>::descendLeftmost(BSTNode<ElementType>* node) {
+    for (; node != NULL; node = node->left)
+        path.push_back(node);
+}
+
+//Description: Extends the path from node down to the largest element below it
+template <class ElementType>
+void BSTIterator<ElementType>::descendRightmost(BSTNode<ElementType>* node) {
+    for (; node != NULL; node = node->right)
+        path.push_back(node);
+}
+
+template <class ElementType>
+ElementType& BSTIterator<ElementType>::operator*() const {
+    return path.back()->element;
+}
+
+template <class ElementType>
+ElementType* BSTIterator<ElementType>::operator->() const {
+    return &path.back()->element;
+}
+
+// Description: Moves to the next element in order, end() after the last one
+template <class ElementType>
+BSTIterator<ElementType>& BSTIterator<ElementType>::operator++() {
+    BSTNode<ElementType>* current = path.back();
+    if (current->right != NULL) {
+        descendLeftmost(current->right);
+        return *this;
+    }
+    // Climb until coming up from a left subtree: that parent is next
+    path.pop_back();
+    while (!path.empty() && path.back()->right == current) {
+        current = path.back();
+        path.pop_back();
+    }
+    return *this;
+}
+
+template <class ElementType>
+BSTIterator<ElementType> BSTIterator<ElementType>::operator++(int) {
+    BSTIterator<ElementType> previous = *this;
+    ++*this;
+    return previous;
+}
+
+// Description: Moves to the previous element in order, the last one from end()
+template <class ElementType>
+BSTIterator<ElementType>& BSTIterator<ElementType>::operator--() {
+    if (path.empty()) {
+        descendRightmost(root);
+        return *this;
+    }
+    BSTNode<ElementType>* current = path.back();
+    if (current->left != NULL) {
+        descendRightmost(current->left);
+        return *this;
+    }
+    // Climb until coming up from a right subtree: that parent is previous
+    path.pop_back();
+    while (!path.empty() && path.back()->left == current) {
+        current = path.back();
+        path.pop_back();
+    }
+    return *this;
+}
+
+template <class ElementType>
+BSTIterator<ElementType> BSTIterator<ElementType>::operator--(int) {
+    BSTIterator<ElementType> next = *this;
+    --*this;
+    return next;
+}
+
+template <class ElementType>
+bool BSTIterator<ElementType>::operator==(const BSTIterator& rhs) const {
+    if (path.empty() || rhs.path.empty())
+        return path.empty() && rhs.path.empty();
+    return path.back() == rhs.path.back();
+}
+
+template <class ElementType>
+bool BSTIterator<ElementType>::operator!=(const BSTIterator& rhs) const {
+    return !(*this == rhs);
+}
@@ -0,0 +1,81 @@
+/*
+ * BSTIterator.h
+ *
+ * Description: Bidirectional in-order iterator over a BST, returned by BST::begin,
+ *              end, lower_bound, upper_bound and equal_range. The nodes have no
+ *              parent links, so the iterator keeps the path from the root down
+ *              to its node: stepping to the next or previous element is O(1)
+ *              amortized and O(height) at worst, and a whole scan is O(n).
+ *
+ *              Like traverseInOrder, an iterator gives access to the elements
+ *              themselves; a change must not alter how an element compares.
+ *              Any insert or remove on the BST invalidates its iterators. With
+ *              SplayPolicy or SemiSplayPolicy so do retrieve, find and contains,
+ *              which restructure the tree: an iterator kept across such a lookup
+ *              may skip elements and end() keeps the old root. lower_bound,
+ *              upper_bound, equal_range and the other queries leave the tree,
+ *              and so the iterators, as they are.
+ *
+ * Class invariant: path is empty (end) or runs from the root to the current node.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "BSTNode.h"
+
+using namespace std;
+
+
+template <class ElementType>
+class BSTIterator {
+
+    // The BST builds iterators by filling in the path
+    template <class, class, class> friend class BST;
+
+private:
+
+    BSTNode<ElementType>* root;
+    vector<BSTNode<ElementType>*> path;   // root to the current node, empty at the end
+
+    //Description: Extends the path from node down to the smallest element below it
+    void descendLeftmost(BSTNode<ElementType>* node);
+
+    //Description: Extends the path from node down to the largest element below it
+    void descendRightmost(BSTNode<ElementType>* node);
+
+public:
+
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef ElementType value_type;
+    typedef ptrdiff_t difference_type;
+    typedef ElementType* pointer;
+    typedef ElementType& reference;
+
+    // Constructors:
+    BSTIterator();                                         // Not attached to any BST
+    explicit BSTIterator(BSTNode<ElementType>* root);      // End of the BST rooted at root
+
+    ElementType& operator*() const;
+    ElementType* operator->() const;
+
+    // Description: Moves to the next element in order, end() after the last one
+    // Time efficiency: O(1) amortized
+    BSTIterator& operator++();
+    BSTIterator operator++(int);
+
+    // Description: Moves to the previous element in order, the last one from end()
+    // Time efficiency: O(1) amortized
+    BSTIterator& operator--();
+    BSTIterator operator--(int);
+
+    bool operator==(const BSTIterator& rhs) const;
+    bool operator!=(const BSTIterator& rhs) const;
+
+}; // end BSTIterator
+
+#include "BSTIterator.cpp"
@@ -15,20 +15,46 @@ template <class ElementType>
 BSTNode<ElementType>::BSTNode() {
 	left = NULL;
 	right = NULL;
+	height = 1;
+	size = 1;
+	this->cacheKeyPrefix(this->element);
 }
 
 template <class ElementType>
-BSTNode<ElementType>::BSTNode(ElementType element) {
-	this->element = element;
+BSTNode<ElementType>::BSTNode(const ElementType& element) : element(element) {
 	left = NULL;
 	right = NULL;
+	height = 1;
+	size = 1;
+	this->cacheKeyPrefix(this->element);
 }
 
 template <class ElementType>
-BSTNode<ElementType>::BSTNode(ElementType element, BSTNode<ElementType>* left, BSTNode<ElementType>* right) {
-	this->element = element;
+BSTNode<ElementType>::BSTNode(ElementType&& element) : element(std::move(element)) {
+	left = NULL;
+	right = NULL;
+	height = 1;
+	size = 1;
+	this->cacheKeyPrefix(this->element);
+}
+
+template <class ElementType>
+BSTNode<ElementType>::BSTNode(const ElementType& element, BSTNode<ElementType>* left, BSTNode<ElementType>* right) : element(element) {
 	this->left = left;
 	this->right = right;	
+	height = 1;
+	updateSize();
+	this->cacheKeyPrefix(this->element);
+}
+
+template <class ElementType>
+template <class... Args>
+BSTNode<ElementType>::BSTNode(in_place_t, Args&&... args) : element(std::forward<Args>(args)...) {
+	left = NULL;
+	right = NULL;
+	height = 1;
+	size = 1;
+	this->cacheKeyPrefix(this->element);
 }
 
 // Boolean helper functions
@@ -45,4 +71,71 @@ bool BSTNode<ElementType>::hasLeft() const {
 template <class ElementType>
 bool BSTNode<ElementType>::hasRight() const {
 	return (right != NULL);
-}
\ No newline at end of file
+}
+
+// Subtree size helpers
+template <class ElementType>
+int BSTNode<ElementType>::leftSize() const {
+	return (left == NULL) ? 0 : left->size;
+}
+
+template <class ElementType>
+int BSTNode<ElementType>::rightSize() const {
+	return (right == NULL) ? 0 : right->size;
+}
+
+template <class ElementType>
+void BSTNode<ElementType>::updateSize() {
+	size = 1 + leftSize() + rightSize();
+}
+
+// Search keys
+template <class ElementType, class Key>
+SearchKey<ElementType, Key>::SearchKey() {
+	key = NULL;
+	prefix = 0;
+	hasPrefix = false;
+}
+
+template <class ElementType, class Key>
+SearchKey<ElementType, Key>::SearchKey(const Key& key) {
+	this->key = &key;
+	prefix = 0;
+	hasPrefix = false;
+	if constexpr (KeyPrefix<ElementType>::enabled)
+		hasPrefix = KeyPrefix<ElementType>::ofKey(key, prefix);
+}
+
+template <class ElementType, class Key>
+int SearchKey<ElementType, Key>::compare(const BSTNode<ElementType>* node) const {
+	if constexpr (KeyPrefix<ElementType>::enabled) {
+		if (hasPrefix && node->keyPrefix != prefix)
+			return (node->keyPrefix < prefix) ? -1 : 1;
+	}
+	return compareKeys(node->element, *key);
+}
+
+// BSTPath
+template <class ElementType>
+BSTPath<ElementType>::BSTPath() {
+	length = 0;
+}
+
+template <class ElementType>
+int BSTPath<ElementType>::size() const {
+	return length;
+}
+
+template <class ElementType>
+void BSTPath<ElementType>::push(BSTNode<ElementType>** link) {
+	if (length < INLINE_LENGTH)
+		inlineLinks[length] = link;
+	else
+		deeperLinks.push_back(link);
+	length++;
+}
+
+template <class ElementType>
+BSTNode<ElementType>**& BSTPath<ElementType>::operator[](int index) {
+	return (index < INLINE_LENGTH) ? inlineLinks[index] : deeperLinks[index - INLINE_LENGTH];
+}
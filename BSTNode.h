@@ -9,29 +9,111 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <utility>
+#include <vector>
+#include "KeyPrefix.h"
 
 using namespace std;
 
+// Key prefix cached in a node when the element type enables KeyPrefix, nothing otherwise
+template <class ElementType, bool Enabled = KeyPrefix<ElementType>::enabled>
+class BSTNodeKeyPrefix {
+protected:
+	void cacheKeyPrefix(const ElementType& element) {}
+};
+
+template <class ElementType>
+class BSTNodeKeyPrefix<ElementType, true> {
+public:
+	uint64_t keyPrefix;          // KeyPrefix<ElementType>::of(element)
+protected:
+	void cacheKeyPrefix(const ElementType& element) { keyPrefix = KeyPrefix<ElementType>::of(element); }
+};
+
 template <class ElementType>
-class BSTNode {
+class BSTNode : public BSTNodeKeyPrefix<ElementType> {
 
 public:
 
 	ElementType element;
 	BSTNode<ElementType>* left;
 	BSTNode<ElementType>* right;
+	int height;                  // Height of the subtree rooted here, kept up to date by balancing policies
+	int size;                    // Number of nodes in the subtree rooted here, kept up to date by BST
 
 	// Constructors
 	BSTNode() ;
-    BSTNode(ElementType element) ;
-    BSTNode(ElementType element, BSTNode<ElementType>* theLeftSubTree, BSTNode<ElementType>* theRightSubTree) ;
+    BSTNode(const ElementType& element) ;
+    BSTNode(ElementType&& element) ;
+    BSTNode(const ElementType& element, BSTNode<ElementType>* theLeftSubTree, BSTNode<ElementType>* theRightSubTree) ;
+
+    // Builds the element in place from the constructor arguments of ElementType
+    template <class... Args>
+    BSTNode(in_place_t, Args&&... args) ;
 
 	// Boolean helper functions
 	bool isLeaf() const;
 	bool hasLeft() const;
 	bool hasRight() const;
 
+	// Subtree size helpers
+	int leftSize() const;
+	int rightSize() const;
+	void updateSize();           // Recomputes size from the children
+
+};
+
+
+// A key being searched for, compared with node after node by a descent. When
+// the nodes cache key prefixes, the prefix of the key is computed once and most
+// levels are decided by comparing it with the cached one.
+template <class ElementType, class Key>
+class SearchKey {
+
+private:
+
+	const Key* key;
+	uint64_t prefix;
+	bool hasPrefix;              // false when prefixes cannot order this key type
+
+public:
+
+	SearchKey() ;
+	explicit SearchKey(const Key& key) ;
+
+	// Three-way comparison of the element of node with the key
+	int compare(const BSTNode<ElementType>* node) const;
+
+};
+
+
+// Links visited by a descent, from the root down, for restructuring the nodes
+// they hold on the way back up. The first INLINE_LENGTH are kept inline: an
+// AVL tree of 2^31 elements is at most 45 nodes high. An unbalanced or a splay
+// tree can be deeper, and its deeper links go to a vector.
+template <class ElementType>
+class BSTPath {
+
+private:
+
+	static const int INLINE_LENGTH = 64;
+
+	BSTNode<ElementType>** inlineLinks[INLINE_LENGTH];
+	vector<BSTNode<ElementType>**> deeperLinks;
+	int length;
+
+public:
+
+	BSTPath() ;
+
+	int size() const;
+	void push(BSTNode<ElementType>** link);
+
+	// The link at depth index, 0 for the root
+	BSTNode<ElementType>**& operator[](int index);
+
 };
 
 #include "BSTNode.cpp"
\ No newline at end of file
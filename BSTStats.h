@@ -0,0 +1,156 @@
+/*
+ * BSTStats.h
+ *
+ * Description: Telemetry of the BST ADT class.
+ *
+ *              BSTStats is the report returned by BST::stats(). Its shape part
+ *              (height, depth histogram, balance factor, memory in use) is
+ *              measured on demand and is always available. Its counters part
+ *              (comparisons per insert, retrieve and remove, nodes allocated and
+ *              freed, depth reached by descents) is only kept when the program
+ *              is compiled with -DBST_ENABLE_STATS. Otherwise the counters are
+ *              not even members of the BST, and every update to them is compiled
+ *              out by BST_STATS, so they cost nothing.
+ *
+ *              Depths count the root as 1, like BST::height().
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+
+// BST_STATS(statement) runs statement only in builds with BST_ENABLE_STATS
+#ifdef BST_ENABLE_STATS
+#define BST_STATS(statement) statement
+#else
+#define BST_STATS(statement)
+#endif
+
+
+enum BSTOperation { INSERT_OPERATION, RETRIEVE_OPERATION, REMOVE_OPERATION };
+
+// Snapshot returned by BST::stats()
+struct BSTStats {
+
+    // Counters, all 0 unless countersEnabled
+    bool countersEnabled;
+    unsigned long operations[3];     // indexed by BSTOperation
+    unsigned long comparisons[3];    // element comparisons made by these operations
+    unsigned long nodesAllocated;
+    unsigned long nodesFreed;
+    int maxDescentDepth;             // deepest level reached by an insert, retrieve or remove
+    double averageDescentDepth;
+
+    // Shape
+    int elementCount;
+    int height;
+    vector<int> depthHistogram;      // depthHistogram[d] nodes at depth d + 1
+    double averageDepth;             // of the nodes
+    double balanceFactor;            // height over the least height of elementCount nodes, 1 is perfect
+    size_t bytesInUse;               // by the nodes, not counting memory their elements own
+    size_t bytesReserved;            // by the allocator, used or not
+
+    BSTStats() : countersEnabled(false), operations(), comparisons(), nodesAllocated(0), nodesFreed(0),
+                 maxDescentDepth(0), averageDescentDepth(0), elementCount(0), height(0),
+                 averageDepth(0), balanceFactor(1), bytesInUse(0), bytesReserved(0) {}
+
+    // Description: Average number of comparisons made by one operation
+    double comparisonsPer(BSTOperation operation) const {
+        return (operations[operation] == 0) ? 0 : (double) comparisons[operation] / operations[operation];
+    }
+
+    // Description: Prints the report, one item per line
+    void print(ostream& out) const {
+        ios_base::fmtflags flags = out.flags();
+        streamsize precision = out.precision();
+        out << "elements: " << elementCount << '\n'
+            << "height: " << height << '\n'
+            << fixed << setprecision(2)
+            << "average depth: " << averageDepth << '\n'
+            << "balance factor: " << balanceFactor << '\n'
+            << "bytes in use: " << bytesInUse << '\n'
+            << "bytes reserved: " << bytesReserved << '\n'
+            << "depth histogram:";
+        for (size_t depth = 0; depth < depthHistogram.size(); depth++)
+            out << ' ' << depth + 1 << ':' << depthHistogram[depth];
+        out << '\n';
+        if (!countersEnabled)
+            out << "counters: disabled (build with -DBST_ENABLE_STATS)" << '\n';
+        else
+            printCounters(out);
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    // Description: Prints the counters part of the report
+    void printCounters(ostream& out) const {
+        static const char* const names[] = { "insert", "retrieve", "remove" };
+        for (int operation = INSERT_OPERATION; operation <= REMOVE_OPERATION; operation++)
+            out << names[operation] << ": " << operations[operation] << " operations, "
+                << comparisonsPer((BSTOperation) operation) << " comparisons each" << '\n';
+        out << "nodes allocated: " << nodesAllocated << '\n'
+            << "nodes freed: " << nodesFreed << '\n'
+            << "max descent depth: " << maxDescentDepth << '\n'
+            << "average descent depth: " << averageDescentDepth << '\n';
+    }
+
+}; // end BSTStats
+
+
+// Counters updated on the hot paths of a BST built with BST_ENABLE_STATS.
+// Lookups are const and may run concurrently, so every counter is atomic;
+// relaxed increments are enough since only the totals matter.
+class BSTCounters {
+
+private:
+
+    atomic<unsigned long> operations[3];
+    atomic<unsigned long> comparisons[3];
+    atomic<unsigned long> nodesAllocated;
+    atomic<unsigned long> nodesFreed;
+    atomic<unsigned long> descentDepthTotal;
+    atomic<int> maxDescentDepth;
+
+public:
+
+    BSTCounters() : operations(), comparisons(), nodesAllocated(0), nodesFreed(0),
+                    descentDepthTotal(0), maxDescentDepth(0) {}
+
+    // Description: Counts one operation that made comparisonCount comparisons
+    //              and descended to depth
+    void record(BSTOperation operation, int comparisonCount, int depth) {
+        operations[operation].fetch_add(1, memory_order_relaxed);
+        comparisons[operation].fetch_add(comparisonCount, memory_order_relaxed);
+        descentDepthTotal.fetch_add(depth, memory_order_relaxed);
+        int deepest = maxDescentDepth.load(memory_order_relaxed);
+        while (depth > deepest && !maxDescentDepth.compare_exchange_weak(deepest, depth, memory_order_relaxed)) {}
+    }
+
+    void nodeAllocated() { nodesAllocated.fetch_add(1, memory_order_relaxed); }
+    void nodeFreed() { nodesFreed.fetch_add(1, memory_order_relaxed); }
+
+    // Description: Copies the counters into stats
+    void report(BSTStats& stats) const {
+        unsigned long descents = 0;
+        stats.countersEnabled = true;
+        for (int operation = INSERT_OPERATION; operation <= REMOVE_OPERATION; operation++) {
+            stats.operations[operation] = operations[operation].load(memory_order_relaxed);
+            stats.comparisons[operation] = comparisons[operation].load(memory_order_relaxed);
+            descents += stats.operations[operation];
+        }
+        stats.nodesAllocated = nodesAllocated.load(memory_order_relaxed);
+        stats.nodesFreed = nodesFreed.load(memory_order_relaxed);
+        stats.maxDescentDepth = maxDescentDepth.load(memory_order_relaxed);
+        stats.averageDescentDepth = (descents == 0) ? 0 : (double) descentDepthTotal.load(memory_order_relaxed) / descents;
+    }
+
+}; // end BSTCounters
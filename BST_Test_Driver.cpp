@@ -7,8 +7,21 @@
 #include <iomanip>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <set>
 #include "BST.h"
+#include "BTree.h"
+#include "ConcurrentBST.h"
+#include "PersistentBST.h"
+#include "HotKeyCache.h"
+#include "MappedDictionary.h"
+#include "DictionaryLoader.h"
 #include "WordPair.h"
+#include "CompactWordPair.h"
 #include "ElementAlreadyExistsInBSTException.h"
 #include "ElementDoesNotExistInBSTException.h"
 
@@ -18,6 +31,1196 @@ void display(WordPair& anElement) {
     cout << anElement.getEnglish() << ":" << anElement.getTranslation() << endl;
 } // end of display
 
+// In-order visitor checking that the elements come out strictly increasing
+int previousInt;
+bool inOrderSorted;
+void checkSorted(int& anElement) {
+    if (anElement <= previousInt)
+        inOrderSorted = false;
+    previousInt = anElement;
+} // end of checkSorted
+
+// Largest height an AVL tree of n elements can reach
+int maxAVLHeight(int n) {
+    return (int) floor(1.44 * log2(n + 2.0));
+} // end of maxAVLHeight
+
+// Loads sorted input into an AVL BST and checks that its height stays logarithmic
+void testBalancedShape(const string& filename) {
+    cout << "Test balanced shape on sorted input: " << endl;
+
+    // Sorted dictionary
+    vector<WordPair> sortedPairs;
+    string aLine = "";
+    ifstream myfile(filename);
+    while (getline(myfile, aLine)) {
+        size_t pos = aLine.find(":");
+        sortedPairs.push_back(WordPair(aLine.substr(0, pos), aLine.substr(pos + 1)));
+    }
+    sort(sortedPairs.begin(), sortedPairs.end());
+
+    BST<WordPair> unbalanced;
+    BST<WordPair, AVLPolicy> balanced;
+    for (size_t i = 0; i < sortedPairs.size(); i++) {
+        try {
+            unbalanced.insert(sortedPairs[i]);
+            balanced.insert(sortedPairs[i]);
+        } catch (ElementAlreadyExistsInBSTException& e) {
+            // duplicate line in the data file
+        }
+    }
+    int n = balanced.getElementCount();
+    cout << "Sorted " << filename << ": " << n << " elements, unbalanced height " << unbalanced.height()
+         << ", AVL height " << balanced.height() << " (bound " << maxAVLHeight(n) << ")" << endl;
+    bool passed = balanced.height() <= maxAVLHeight(n);
+    for (size_t i = 0; i < sortedPairs.size(); i++) {
+        if (!(balanced.retrieve(sortedPairs[i]) == sortedPairs[i]))
+            passed = false;
+    }
+
+    // Sorted integers, then every other one removed
+    const int count = 100000;
+    BST<int, AVLPolicy> numbers;
+    for (int i = 0; i < count; i++)
+        numbers.insert(i);
+    cout << "Sorted 0.." << count - 1 << ": AVL height " << numbers.height()
+         << " (bound " << maxAVLHeight(count) << ")" << endl;
+    passed = passed && numbers.height() <= maxAVLHeight(count);
+    for (int i = 0; i < count; i += 2)
+        numbers.remove(i);
+    cout << "After removing even numbers: " << numbers.getElementCount() << " elements, AVL height "
+         << numbers.height() << " (bound " << maxAVLHeight(numbers.getElementCount()) << ")" << endl;
+    passed = passed && numbers.getElementCount() == count / 2 && numbers.nodesCount() == count / 2;
+    passed = passed && numbers.height() <= maxAVLHeight(numbers.getElementCount());
+    previousInt = -1;
+    inOrderSorted = true;
+    numbers.traverseInOrder(checkSorted);
+    passed = passed && inOrderSorted;
+    for (int i = 0; i < count; i++) {
+        try {
+            numbers.retrieve(i);
+            passed = passed && (i % 2 == 1);
+        } catch (ElementDoesNotExistInBSTException& e) {
+            passed = passed && (i % 2 == 0);
+        }
+    }
+
+    cout << "Balanced shape test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testBalancedShape
+
+// Builds trees from sorted and unsorted input and checks their shape and content
+void testBulkLoad() {
+    cout << "Test bulk load: " << endl;
+    bool passed = true;
+
+    // Every size up to 2^10, shapes must be height-optimal
+    for (int count = 0; count <= 1024; count++) {
+        vector<int> numbers;
+        for (int i = 0; i < count; i++)
+            numbers.push_back(i * 2);
+        BST<int, AVLPolicy> numbersTree;
+        numbersTree.buildFromSorted(numbers.begin(), numbers.end());
+        int optimalHeight = (int) ceil(log2(count + 1.0));
+        passed = passed && numbersTree.getElementCount() == count && numbersTree.nodesCount() == count;
+        passed = passed && numbersTree.height() == optimalHeight;
+        previousInt = -1;
+        inOrderSorted = true;
+        numbersTree.traverseInOrder(checkSorted);
+        passed = passed && inOrderSorted;
+    }
+
+    // Built trees stay valid AVL trees under further updates
+    vector<int> numbers;
+    for (int i = 0; i < 1000; i++)
+        numbers.push_back(i * 2);
+    BST<int, AVLPolicy> numbersTree;
+    numbersTree.buildFromSorted(numbers.begin(), numbers.end());
+    for (int i = 0; i < 1000; i++)
+        numbersTree.insert(i * 2 + 1);
+    for (int i = 0; i < 1000; i += 3)
+        numbersTree.remove(i);
+    passed = passed && numbersTree.height() <= maxAVLHeight(numbersTree.getElementCount());
+    passed = passed && numbersTree.nodesCount() == numbersTree.getElementCount();
+
+    // Unsorted input with duplicates, first occurrence wins
+    vector<WordPair> pairs;
+    pairs.push_back(WordPair("stream", "strom"));
+    pairs.push_back(WordPair("beer", "ol"));
+    pairs.push_back(WordPair("stream", "elv"));
+    pairs.push_back(WordPair("leaf", "blad"));
+    pairs.push_back(WordPair("beer", "pils"));
+    vector<WordPair> duplicates;
+    BST<WordPair> pairsTree;
+    int duplicateCount = pairsTree.buildFromUnsorted(pairs.begin(), pairs.end(), &duplicates);
+    cout << "Built " << pairsTree.getElementCount() << " pairs, " << duplicateCount << " duplicates left out" << endl;
+    passed = passed && duplicateCount == 2 && duplicates.size() == 2 && pairsTree.getElementCount() == 3;
+    passed = passed && pairsTree.retrieve(WordPair("stream")).getTranslation() == "strom";
+    passed = passed && pairsTree.retrieve(WordPair("beer")).getTranslation() == "ol";
+    passed = passed && pairsTree.min().getEnglish() == "beer" && pairsTree.max().getEnglish() == "stream";
+
+    cout << "Bulk load test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testBulkLoad
+
+// In-order visitor over a frozen snapshot
+void checkSortedFrozen(const int& anElement) {
+    if (anElement <= previousInt)
+        inOrderSorted = false;
+    previousInt = anElement;
+} // end of checkSortedFrozen
+
+// Freezes trees of every size up to 1000 and compares lookups against the live tree
+void testFreeze(BST<WordPair>* theTranslator) {
+    cout << "Test freeze: " << endl;
+    bool passed = true;
+
+    for (int count = 0; count <= 1000; count++) {
+        BST<int, AVLPolicy> numbersTree;
+        for (int i = 0; i < count; i++)
+            numbersTree.insert((i * 7919) % 1009 * 2);  // distinct even numbers in mixed order
+        FrozenBST<int> frozen = numbersTree.freeze();
+        passed = passed && frozen.getElementCount() == count;
+        for (int i = -1; i <= 2 * 1009; i++)
+            passed = passed && frozen.contains(i) == numbersTree.contains(i);
+        previousInt = -1;
+        inOrderSorted = true;
+        frozen.traverseInOrder(checkSortedFrozen);
+        passed = passed && inOrderSorted;
+        if (count > 0)
+            passed = passed && frozen.min() == numbersTree.min() && frozen.max() == numbersTree.max();
+    }
+
+    FrozenBST<WordPair> frozenTranslator = theTranslator->freeze();
+    cout << "Frozen translator: " << frozenTranslator.getElementCount() << " pairs, 'cloud' => "
+         << frozenTranslator.retrieve(WordPair("cloud")).getTranslation() << endl;
+    passed = passed && frozenTranslator.getElementCount() == theTranslator->getElementCount();
+    passed = passed && frozenTranslator.find("cloud") == frozenTranslator.find(string("cloud"));
+    passed = passed && frozenTranslator.find("leaf") == NULL;
+
+    cout << "Freeze test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testFreeze
+
+// Applies the same inserts and removes to a BTree and a BST and compares them
+void testBTree() {
+    cout << "Test BTree: " << endl;
+    bool passed = true;
+
+    BTree<int, 5> smallNodes;
+    BTree<int> wideNodes;
+    BST<int, AVLPolicy> reference;
+    srand(9);
+    for (int i = 0; i < 20000; i++) {
+        int number = rand() % 5000;
+        bool inReference = reference.contains(number);
+        if (rand() % 3 != 0) {
+            if (!inReference) {
+                reference.insert(number);
+                smallNodes.insert(number);
+                wideNodes.insert(number);
+            } else {
+                try {
+                    smallNodes.insert(number);
+                    passed = false;
+                } catch (ElementAlreadyExistsInBSTException& e) {
+                }
+            }
+        } else if (inReference) {
+            reference.remove(number);
+            smallNodes.remove(number);
+            wideNodes.remove(number);
+        }
+    }
+    for (int number = 0; number < 5000; number++) {
+        passed = passed && smallNodes.contains(number) == reference.contains(number);
+        passed = passed && wideNodes.contains(number) == reference.contains(number);
+    }
+    passed = passed && smallNodes.getElementCount() == reference.getElementCount();
+    passed = passed && wideNodes.getElementCount() == reference.getElementCount();
+    passed = passed && smallNodes.min() == reference.min() && wideNodes.max() == reference.max();
+    previousInt = -1;
+    inOrderSorted = true;
+    smallNodes.traverseInOrder(checkSorted);
+    passed = passed && inOrderSorted;
+    cout << reference.getElementCount() << " elements: BST height " << reference.height() << ", BTree<int, 5> height "
+         << smallNodes.height() << ", BTree<int> height " << wideNodes.height() << endl;
+
+    cout << "BTree test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testBTree
+
+// Compares retrieveBatch against one find per key, hits and misses mixed
+void testRetrieveBatch(BST<WordPair>* theTranslator) {
+    cout << "Test retrieveBatch: " << endl;
+    bool passed = true;
+
+    BST<int, AVLPolicy> numbers;
+    for (int i = 0; i < 5000; i++)
+        numbers.insert(i * 3);
+    vector<int> keys;
+    for (int i = 0; i < 1000; i++)
+        keys.push_back(rand() % 16000 - 500);
+    vector<int*> results;
+    int hits = numbers.retrieveBatch(keys, results);
+    int expectedHits = 0;
+    passed = passed && results.size() == keys.size();
+    for (size_t i = 0; i < keys.size(); i++) {
+        passed = passed && results[i] == numbers.find(keys[i]);
+        if (results[i] != NULL)
+            expectedHits++;
+    }
+    passed = passed && hits == expectedHits;
+
+    vector<string_view> words;
+    words.push_back("cloud");
+    words.push_back("leaf");
+    words.push_back("beer");
+    vector<WordPair*> translations;
+    hits = theTranslator->retrieveBatch(words, translations);
+    cout << "Batch of 3 words: " << hits << " translated" << endl;
+    passed = passed && hits == 2 && translations[1] == NULL && translations[2]->getTranslation() == "ol";
+
+    BST<int> empty;
+    passed = passed && empty.retrieveBatch(keys, results) == 0 && results.size() == keys.size() && results[0] == NULL;
+
+    cout << "retrieveBatch test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testRetrieveBatch
+
+// Saves the translator in the binary format, maps it back and compares lookups
+void testMappedDictionary(BST<WordPair>* theTranslator) {
+    cout << "Test mapped dictionary: " << endl;
+    bool passed = true;
+    string dictFilename = "testTranslator.dict";
+
+    passed = passed && MappedDictionary::save(*theTranslator, dictFilename);
+    MappedDictionary theDictionary;
+    passed = passed && theDictionary.open(dictFilename);
+    passed = passed && theDictionary.getElementCount() == theTranslator->getElementCount();
+    string_view translation;
+    passed = passed && theDictionary.find("cloud", translation) && translation == "sky";
+    passed = passed && !theDictionary.find("leaf", translation) && !theDictionary.find("", translation);
+    passed = passed && theDictionary.find(theTranslator->min().getEnglish(), translation);
+    passed = passed && theDictionary.find(theTranslator->max().getEnglish(), translation);
+    passed = passed && translation == theTranslator->max().getTranslation();
+    cout << "Mapped " << theDictionary.getElementCount() << " pairs, 'cloud' => " << theDictionary.find("cloud", translation)
+         << ":" << translation << endl;
+    theDictionary.close();
+
+    // A flipped byte in the blob must be caught by the checksum
+    fstream file(dictFilename, ios::in | ios::out | ios::binary);
+    file.seekp(-1, ios::end);
+    file.put('#');
+    file.close();
+    passed = passed && !theDictionary.open(dictFilename) && theDictionary.open(dictFilename, false);
+    theDictionary.close();
+
+    // Sizes crafted so that header + entries + blob wraps around to the file size
+    // must be rejected even without verification
+    file.open(dictFilename, ios::in | ios::out | ios::binary);
+    file.seekg(0, ios::end);
+    uint64_t available = (uint64_t) file.tellg() - 32;   // past the 32-byte header
+    uint32_t entryCount = 0xFFFFFFFF;
+    uint64_t blobSize = available - (uint64_t) entryCount * 16;
+    file.seekp(12);
+    file.write(reinterpret_cast<const char*>(&entryCount), sizeof(entryCount));
+    file.write(reinterpret_cast<const char*>(&blobSize), sizeof(blobSize));
+    file.close();
+    passed = passed && !theDictionary.open(dictFilename, false);
+    remove(dictFilename.c_str());
+    passed = passed && !theDictionary.open(dictFilename);
+
+    cout << "Mapped dictionary test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testMappedDictionary
+
+// True if both sequences hold the same word pairs, translations included, in the same order
+bool samePairs(const vector<WordPair>& lhs, const vector<WordPair>& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (!(lhs[i] == rhs[i]) || lhs[i].getTranslation() != rhs[i].getTranslation())
+            return false;
+    }
+    return true;
+} // end of samePairs
+
+// Loads dictionaries with the parallel loader and compares them with the
+// line-by-line load into buildFromUnsorted, for several thread counts
+void testParallelLoad(const string& filename) {
+    cout << "Test parallel load: " << endl;
+    bool passed = true;
+
+    // A larger dictionary with repeated words, a line without ':', an empty
+    // line and no line break at the end
+    string bigFilename = "testParallelLoad.txt";
+    ofstream bigFile(bigFilename);
+    unsigned int seed = 9;
+    for (int i = 0; i < 20000; i++)
+        bigFile << "w" << rand_r(&seed) % 15000 << ":t" << i << "\n";
+    bigFile << "nocolon\n\nlast:line";
+    bigFile.close();
+
+    string filenames[] = {filename, bigFilename};
+    for (const string& aFilename : filenames) {
+        vector<WordPair> wordPairs;
+        string aLine = "";
+        ifstream myfile(aFilename);
+        while (getline(myfile, aLine)) {
+            size_t pos = aLine.find(":");
+            wordPairs.push_back(WordPair(aLine.substr(0, pos), aLine.substr(pos + 1)));
+        }
+        myfile.close();
+        BST<WordPair> expected;
+        vector<WordPair> expectedDuplicates;
+        expected.buildFromUnsorted(wordPairs.begin(), wordPairs.end(), &expectedDuplicates);
+        vector<WordPair> expectedPairs;
+        auto collect = [&](const WordPair& aPair) { expectedPairs.push_back(aPair); };
+        expected.traverseInOrder(collect);
+
+        for (unsigned threadCount : {1u, 3u, 8u}) {
+            DictionaryLoader loader(threadCount);
+            vector<WordPair> loaded;
+            vector<WordPair> duplicates;
+            passed = passed && loader.load(aFilename, loaded, &duplicates);
+            passed = passed && samePairs(loaded, expectedPairs) && samePairs(duplicates, expectedDuplicates);
+
+            BST<WordPair> theTranslator;
+            theTranslator.buildFromSorted(loaded.begin(), loaded.end());
+            passed = passed && theTranslator.getElementCount() == expected.getElementCount();
+        }
+        cout << aFilename << ": " << expectedPairs.size() << " pairs, " << expectedDuplicates.size() << " duplicates" << endl;
+    }
+    remove(bigFilename.c_str());
+
+    DictionaryLoader loader;
+    vector<WordPair> loaded;
+    passed = passed && !loader.load(bigFilename, loaded) && loaded.empty();
+
+    cout << "Parallel load test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testParallelLoad
+
+// Walks BSTs with iterators and compares bounds and prefix ranges with std::set
+void testRangeQueries(BST<WordPair>* theTranslator) {
+    cout << "Test iterators and range queries: " << endl;
+    bool passed = true;
+
+    // Forward and backward scans see the same elements as traverseInOrder
+    vector<WordPair> inOrder;
+    auto collect = [&](const WordPair& aPair) { inOrder.push_back(aPair); };
+    theTranslator->traverseInOrder(collect);
+    vector<WordPair> forward(theTranslator->begin(), theTranslator->end());
+    vector<WordPair> backward;
+    for (BST<WordPair>::iterator it = theTranslator->end(); it != theTranslator->begin(); )
+        backward.push_back(*--it);
+    reverse(backward.begin(), backward.end());
+    passed = passed && samePairs(forward, inOrder) && samePairs(backward, inOrder);
+
+    // Bounds of present and absent keys, in an unbalanced and an AVL tree
+    unsigned int seed = 14;
+    set<int> expected;
+    BST<int> unbalanced;
+    BST<int, AVLPolicy> balanced;
+    for (int i = 0; i < 2000; i++) {
+        int value = 2 * (rand_r(&seed) % 3000);
+        if (expected.insert(value).second) {
+            unbalanced.insert(value);
+            balanced.insert(value);
+        }
+    }
+    for (int key = -1; key <= 6001; key++) {
+        set<int>::iterator lower = expected.lower_bound(key);
+        set<int>::iterator upper = expected.upper_bound(key);
+        BST<int>::iterator unbalancedLower = unbalanced.lower_bound(key);
+        BST<int, AVLPolicy>::iterator balancedUpper = balanced.upper_bound(key);
+        passed = passed && (lower == expected.end() ? unbalancedLower == unbalanced.end() : *unbalancedLower == *lower);
+        passed = passed && (upper == expected.end() ? balancedUpper == balanced.end() : *balancedUpper == *upper);
+        if (upper != expected.end() && ++upper != expected.end())
+            passed = passed && *++balancedUpper == *upper;
+    }
+    passed = passed && equal(expected.begin(), expected.end(), balanced.begin()) && equal(expected.rbegin(), expected.rend(),
+                                                                                          make_reverse_iterator(unbalanced.end()));
+
+    // Prefix ranges hold exactly the words starting with the prefix
+    for (string prefix : {"c", "clo", "s", "", "zzz", "cloudy"}) {
+        pair<BST<WordPair>::iterator, BST<WordPair>::iterator> range = theTranslator->equal_range(WordPrefix(prefix));
+        vector<WordPair> matches(range.first, range.second);
+        vector<WordPair> expectedMatches;
+        for (size_t i = 0; i < inOrder.size(); i++) {
+            if (inOrder[i].getEnglish().compare(0, prefix.size(), prefix) == 0)
+                expectedMatches.push_back(inOrder[i]);
+        }
+        passed = passed && samePairs(matches, expectedMatches);
+    }
+    pair<BST<WordPair>::iterator, BST<WordPair>::iterator> range = theTranslator->equal_range(WordPrefix("c"));
+    cout << "Words starting with 'c':";
+    for (BST<WordPair>::iterator it = range.first; it != range.second; ++it)
+        cout << " " << it->getEnglish();
+    cout << endl;
+
+    BST<int> empty;
+    passed = passed && empty.begin() == empty.end() && empty.lower_bound(3) == empty.end();
+
+    cout << "Iterators and range queries test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testRangeQueries
+
+// Checks the three traversal orders and early termination of traverse
+void testTraverse() {
+    cout << "Test traverse: " << endl;
+    bool passed = true;
+
+    //        4
+    //      2   6
+    //     1 3 5 7
+    BST<int> numbers;
+    int values[] = {4, 2, 6, 1, 3, 5, 7};
+    for (int value : values)
+        numbers.insert(value);
+
+    vector<int> visited;
+    auto record = [&](int anElement) { visited.push_back(anElement); };
+    passed = passed && numbers.traverse(record, PRE_ORDER) && visited == vector<int>({4, 2, 1, 3, 6, 5, 7});
+    visited.clear();
+    passed = passed && numbers.traverse(record, IN_ORDER) && visited == vector<int>({1, 2, 3, 4, 5, 6, 7});
+    visited.clear();
+    passed = passed && numbers.traverse(record, POST_ORDER) && visited == vector<int>({1, 3, 2, 5, 7, 6, 4});
+
+    // Stops as soon as the visitor returns false
+    for (TraversalOrder order : {PRE_ORDER, IN_ORDER, POST_ORDER}) {
+        int count = 0;
+        passed = passed && !numbers.traverse([&](int) { return ++count < 3; }, order) && count == 3;
+    }
+
+    // Sums and counts in one pass, no globals
+    long sum = 0;
+    numbers.traverse([&](int anElement) { sum += anElement; });
+    passed = passed && sum == 28;
+
+    BTree<int, 4> wide;
+    for (int i = 0; i < 200; i++)
+        wide.insert((i * 37) % 200);
+    for (TraversalOrder order : {PRE_ORDER, IN_ORDER, POST_ORDER}) {
+        visited.clear();
+        passed = passed && wide.traverse(record, order) && visited.size() == 200;
+        if (order == IN_ORDER)
+            passed = passed && is_sorted(visited.begin(), visited.end());
+        int count = 0;
+        passed = passed && !wide.traverse([&](int) { return ++count < 50; }, order) && count == 50;
+    }
+    // The root's elements (at most 4) come first in pre-order and last in post-order
+    visited.clear();
+    wide.traverse(record, PRE_ORDER);
+    int preOrderRoot = visited[0];
+    visited.clear();
+    wide.traverse(record, POST_ORDER);
+    passed = passed && find(visited.end() - 4, visited.end(), preOrderRoot) != visited.end();
+
+    cout << "Traverse test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testTraverse
+
+// Checks rank, select, countRange and nth against std::set after random inserts and removes
+template <class Tree>
+bool checkOrderStatistics(Tree& numbers, const set<int>& expected) {
+    bool passed = numbers.nodesCount() == (int) expected.size();
+    int index = 0;
+    for (set<int>::const_iterator it = expected.begin(); it != expected.end(); ++it, index++) {
+        passed = passed && numbers.select(index) == *it && numbers.rank(*it) == index && numbers.rank(*it + 1) == index + 1;
+        passed = passed && *numbers.nth(index) == *it;
+    }
+    passed = passed && numbers.nth(index) == numbers.end();
+    passed = passed && numbers.countRange(100, 400) == (int) distance(expected.lower_bound(100), expected.lower_bound(400));
+    return passed;
+} // end of checkOrderStatistics
+
+void testOrderStatistics(BST<WordPair>* theTranslator) {
+    cout << "Test order statistics: " << endl;
+    bool passed = true;
+
+    unsigned int seed = 16;
+    set<int> expected;
+    BST<int> unbalanced;
+    BST<int, AVLPolicy> balanced;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 300; i++) {
+            int value = rand_r(&seed) % 500;
+            if (expected.insert(value).second) {
+                unbalanced.insert(value);
+                balanced.emplace(value);
+            } else {
+                try {
+                    balanced.insert(value);
+                    passed = false;
+                } catch (ElementAlreadyExistsInBSTException&) {
+                }
+            }
+        }
+        for (int i = 0; i < 200; i++) {
+            int value = rand_r(&seed) % 500;
+            if (expected.erase(value) == 1) {
+                unbalanced.remove(value);
+                balanced.remove(value);
+            }
+        }
+        passed = passed && checkOrderStatistics(unbalanced, expected) && checkOrderStatistics(balanced, expected);
+    }
+    try {
+        balanced.select(balanced.nodesCount());
+        passed = false;
+    } catch (ElementDoesNotExistInBSTException&) {
+    }
+
+    // Sorted inserts make a list far deeper than the inline part of a recorded path
+    BST<int> list;
+    set<int> listed;
+    for (int i = 0; i < 200; i++) {
+        list.insert(i);
+        listed.insert(i);
+    }
+    for (int i = 150; i < 200; i += 3) {
+        list.remove(i);
+        listed.erase(i);
+    }
+    passed = passed && list.height() == (int) listed.size() && checkOrderStatistics(list, listed);
+
+    // Built in one go, then paged through
+    vector<int> sorted(expected.begin(), expected.end());
+    BST<int> built;
+    built.buildFromSorted(sorted.begin(), sorted.end());
+    passed = passed && checkOrderStatistics(built, expected);
+    const int pageSize = 25;
+    vector<int> paged;
+    for (int page = 0; page * pageSize < built.nodesCount(); page++) {
+        BST<int>::iterator it = built.nth(page * pageSize);
+        for (int i = 0; i < pageSize && it != built.end(); i++, ++it)
+            paged.push_back(*it);
+    }
+    passed = passed && paged == sorted && built.median() == sorted[(sorted.size() - 1) / 2];
+
+    int cWords = theTranslator->countRange(string_view("c"), string_view("d"));
+    cout << "Median word: " << theTranslator->median().getEnglish() << ", words starting with 'c': " << cWords << endl;
+    passed = passed && cWords == (int) distance(theTranslator->lower_bound(WordPrefix("c")), theTranslator->upper_bound(WordPrefix("c")));
+
+    cout << "Order statistics test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testOrderStatistics
+
+// Compares union, intersection, difference and eraseRange with std::set results
+void testSetOperations(BST<WordPair>* theTranslator) {
+    cout << "Test set operations: " << endl;
+    bool passed = true;
+
+    unsigned int seed = 17;
+    for (int operation = 0; operation < 4; operation++) {
+        set<int> expected;
+        set<int> others;
+        BST<int, AVLPolicy> numbers;
+        BST<int, AVLPolicy> otherNumbers;
+        for (int i = 0; i < 20000; i++) {
+            int value = rand_r(&seed) % 30000;
+            if (expected.insert(value).second)
+                numbers.insert(value);
+            value = rand_r(&seed) % 30000;
+            if (i % 4 == 0 && others.insert(value).second)
+                otherNumbers.insert(value);
+        }
+        set<int> result;
+        int changed = 0;
+        if (operation == 0) {
+            vector<int> duplicates;
+            changed = numbers.unionWith(otherNumbers, &duplicates);
+            set_union(expected.begin(), expected.end(), others.begin(), others.end(), inserter(result, result.end()));
+            passed = passed && changed == (int) duplicates.size() && changed == (int) (expected.size() + others.size() - result.size());
+        } else if (operation == 1) {
+            changed = numbers.intersectWith(otherNumbers);
+            set_intersection(expected.begin(), expected.end(), others.begin(), others.end(), inserter(result, result.end()));
+        } else if (operation == 2) {
+            changed = numbers.difference(otherNumbers);
+            set_difference(expected.begin(), expected.end(), others.begin(), others.end(), inserter(result, result.end()));
+        } else {
+            changed = numbers.eraseRange(5000, 25000);
+            result.insert(expected.begin(), expected.lower_bound(5000));
+            result.insert(expected.lower_bound(25000), expected.end());
+        }
+        if (operation != 0)
+            passed = passed && changed == (int) (expected.size() - result.size());
+        passed = passed && numbers.getElementCount() == (int) result.size() && equal(result.begin(), result.end(), numbers.begin());
+        passed = passed && numbers.height() <= maxAVLHeight(numbers.getElementCount());
+    }
+
+    // An empty BST against itself, and sorted inserts into an unbalanced BST,
+    // which make a single path
+    BST<int> empty;
+    passed = passed && empty.difference(empty) == 0 && empty.intersectWith(empty) == 0 && empty.unionWith(empty) == 0;
+    passed = passed && empty.getElementCount() == 0 && empty.begin() == empty.end();
+    BST<int> path;
+    BST<int> evens;
+    for (int i = 0; i < 5000; i++) {
+        path.insert(i);
+        if (i % 2 == 0)
+            evens.insert(i);
+    }
+    BST<int> odds(path);
+    passed = passed && odds.difference(evens) == 2500 && odds.intersectWith(path) == 0;
+    passed = passed && path.eraseRange(1000, 4000) == 3000 && path.intersectWith(odds) == 1000;
+    passed = passed && odds.unionWith(path) == 1000 && odds.getElementCount() == 2500 && odds.nth(0) != odds.end() && *odds.nth(0) == 1;
+    bool oddsInOrder = true;
+    int expectedOdd = 1;
+    for (BST<int>::iterator it = odds.begin(); it != odds.end(); ++it, expectedOdd += 2)
+        oddsInOrder = oddsInOrder && *it == expectedOdd;
+    passed = passed && oddsInOrder && path.getElementCount() == 1000;
+
+    // Merging a new release keeps the known translations and reports the others
+    BST<WordPair> merged(*theTranslator);
+    BST<WordPair> release;
+    release.insert(WordPair("cloud", "nuage"));
+    release.insert(WordPair("comet", "comete"));
+    release.insert(WordPair("zenith", "zenith"));
+    vector<WordPair> duplicates;
+    int duplicateCount = merged.unionWith(release, &duplicates);
+    passed = passed && duplicateCount == 1 && duplicates[0].getTranslation() == "nuage";
+    passed = passed && merged.getElementCount() == theTranslator->getElementCount() + 2 && merged.retrieve(WordPair("cloud")).getTranslation() == "sky";
+    int erased = merged.eraseRange(string_view("c"), string_view("d"));
+    passed = passed && erased == 4 && !merged.contains("comet") && merged.contains("zenith");
+    passed = passed && merged.difference(release) == 1 && merged.intersectWith(*theTranslator) == 0;
+    cout << "Merged release: " << duplicateCount << " duplicate, erased " << erased << " words starting with 'c'" << endl;
+
+    cout << "Set operations test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testSetOperations
+
+// Words around the 8 bytes compared as one integer: equal prefixes, embedded '\0', bytes above 127
+vector<string> prefixEdgeWords() {
+    return {"", "a", string("a\0", 2), string("a\0b", 3), "ab", "abcdefgh", "abcdefghi", "abcdefgg",
+            "abcdefghij", "abcdefgh\xff", "\xff", "\xe9t\xe9", "cloud", "clouds", "zzzzzzzzzzzz"};
+} // end of prefixEdgeWords
+
+int sign(int value) {
+    return (value > 0) - (value < 0);
+} // end of sign
+
+// Checks the three-way comparisons of WordPair and descents over cached key prefixes
+void testThreeWayCompare() {
+    cout << "Test three-way compare: " << endl;
+    bool passed = true;
+
+    vector<string> words = prefixEdgeWords();
+    BST<WordPair> edgeWords;
+    BST<WordPair, AVLPolicy> balancedEdgeWords;
+    for (size_t i = 0; i < words.size(); i++) {
+        WordPair lhs(words[i]);
+        for (size_t j = 0; j < words.size(); j++) {
+            WordPair rhs(words[j]);
+            int expected = (lhs < rhs) ? -1 : ((lhs == rhs) ? 0 : 1);
+            passed = passed && sign(lhs.compare(rhs)) == expected && sign(lhs.compare(string_view(words[j]))) == expected;
+            passed = passed && sign(compareKeys(lhs, rhs)) == expected;
+            bool prefixesDiffer = bigEndianPrefix(words[i]) != bigEndianPrefix(words[j]);
+            passed = passed && (!prefixesDiffer || (bigEndianPrefix(words[i]) < bigEndianPrefix(words[j])) == (expected < 0));
+            int expectedPrefix = (lhs == WordPrefix(words[j])) ? 0 : ((lhs < WordPrefix(words[j])) ? -1 : 1);
+            passed = passed && sign(lhs.compare(WordPrefix(words[j]))) == expectedPrefix;
+        }
+        edgeWords.insert(lhs);
+        balancedEdgeWords.insert(lhs);
+    }
+    for (size_t i = 0; i < words.size(); i++) {
+        passed = passed && edgeWords.find(words[i]) != NULL && edgeWords.find(words[i])->getEnglish() == words[i];
+        passed = passed && balancedEdgeWords.contains(WordPair(words[i])) && balancedEdgeWords.contains(words[i] + "~") == false;
+        passed = passed && edgeWords.duplicate(WordPair(words[i])) == 1;
+    }
+    vector<string_view> keys(words.begin(), words.end());
+    keys.push_back("abcdefgh~");
+    vector<WordPair*> results;
+    passed = passed && edgeWords.retrieveBatch(keys, results) == (int) words.size() && results.back() == NULL;
+    int integers = 0;
+    BST<int> numbers;
+    for (int i = 0; i < 100; i++)
+        numbers.insert((i * 7) % 100);
+    for (int i = 0; i < 100; i++)
+        integers += numbers.contains(i);
+    passed = passed && integers == 100 && sign(compareKeys(3, 5)) == -1 && compareKeys(4, 4) == 0;
+
+    cout << "Three-way compare test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testThreeWayCompare
+
+// Checks the shape reported by stats() and, in builds with BST_ENABLE_STATS, its counters
+void testStats(BST<WordPair>* theTranslator) {
+    cout << "Test stats: " << endl;
+    bool passed = true;
+
+    // Sorted inserts make a list of 10 nodes, a balanced build a full tree of 7
+    BST<int> degenerate;
+    for (int i = 0; i < 10; i++)
+        degenerate.insert(i);
+    BSTStats listStats = degenerate.stats();
+    passed = passed && listStats.elementCount == 10 && listStats.height == 10 && listStats.averageDepth == 5.5;
+    passed = passed && listStats.balanceFactor == 2.5 && listStats.depthHistogram == vector<int>(10, 1);
+    passed = passed && listStats.bytesInUse == 10 * sizeof(BSTNode<int>) && listStats.bytesReserved >= listStats.bytesInUse;
+
+    int sorted[] = { 1, 2, 3, 4, 5, 6, 7 };
+    BST<int, AVLPolicy, NewDeleteAllocator<int> > balanced;
+    balanced.buildFromSorted(sorted, sorted + 7);
+    BSTStats treeStats = balanced.stats();
+    passed = passed && treeStats.height == 3 && treeStats.balanceFactor == 1 && treeStats.bytesReserved == treeStats.bytesInUse;
+    passed = passed && treeStats.depthHistogram == vector<int>({ 1, 2, 4 });
+    passed = passed && BST<int>().stats().height == 0 && BST<int>().stats().depthHistogram.empty();
+
+#ifdef BST_ENABLE_STATS
+    // Every node is compared on the way to the end of the list, once: inserts
+    // and removes resize the ancestors through the path they recorded
+    degenerate.contains(9);
+    degenerate.contains(10);
+    degenerate.remove(0);
+    listStats = degenerate.stats();
+    passed = passed && listStats.countersEnabled && listStats.operations[INSERT_OPERATION] == 10;
+    passed = passed && listStats.comparisons[INSERT_OPERATION] == 45;
+    passed = passed && listStats.comparisonsPer(RETRIEVE_OPERATION) == 10 && listStats.maxDescentDepth == 10;
+    passed = passed && listStats.operations[REMOVE_OPERATION] == 1 && listStats.comparisons[REMOVE_OPERATION] == 1;
+    passed = passed && listStats.nodesAllocated == 10 && listStats.nodesFreed == 1;
+    passed = passed && balanced.stats().nodesAllocated == 7 && balanced.stats().operations[INSERT_OPERATION] == 0;
+#else
+    passed = passed && !listStats.countersEnabled && listStats.operations[RETRIEVE_OPERATION] == 0;
+#endif
+
+    theTranslator->stats().print(cout);
+
+    cout << "Stats test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testStats
+
+// Checks that a copy has the shape and elements of the original and is independent
+// of it, and that moves hand the nodes over
+void testCopyAndMove(BST<WordPair>* theTranslator) {
+    cout << "Test copy and move: " << endl;
+    bool passed = true;
+
+    BST<WordPair> copy(*theTranslator);
+    BSTStats originalStats = theTranslator->stats();
+    BSTStats copyStats = copy.stats();
+    passed = passed && copyStats.depthHistogram == originalStats.depthHistogram && copy.nodesCount() == theTranslator->nodesCount();
+    passed = passed && equal(copy.begin(), copy.end(), theTranslator->begin(), theTranslator->end());
+    passed = passed && copyStats.bytesReserved == copyStats.bytesInUse;
+    copy.remove(WordPair("cloud"));
+    passed = passed && theTranslator->contains("cloud") && !copy.contains("cloud") && copy.select(0) == theTranslator->select(0);
+
+    // Heights and sizes come along, so the copy goes on rebalancing and answering ranks
+    BST<int, AVLPolicy> numbers;
+    for (int i = 0; i < 1000; i++)
+        numbers.insert(i);
+    BST<int, AVLPolicy> numbersCopy(numbers);
+    for (int i = 1000; i < 2000; i++)
+        numbersCopy.insert(i);
+    passed = passed && numbersCopy.height() <= 15 && numbersCopy.rank(1500) == 1500 && numbers.getElementCount() == 1000;
+#ifdef BST_ENABLE_STATS
+    passed = passed && BST<int, AVLPolicy>(numbers).stats().comparisons[INSERT_OPERATION] == 0;
+#endif
+
+    BST<int, AVLPolicy> moved(std::move(numbersCopy));
+    passed = passed && moved.getElementCount() == 2000 && numbersCopy.getElementCount() == 0 && numbersCopy.begin() == numbersCopy.end();
+    numbersCopy.insert(7);
+    passed = passed && numbersCopy.nodesCount() == 1 && moved.contains(1999);
+    numbersCopy = std::move(moved);
+    passed = passed && numbersCopy.getElementCount() == 2000 && moved.getElementCount() == 0 && numbersCopy.select(7) == 7;
+    moved = numbersCopy;
+    moved = moved;
+    passed = passed && moved.getElementCount() == 2000 && moved.rank(1000) == 1000 && numbersCopy.contains(0);
+    static_assert(is_nothrow_move_constructible<BST<WordPair> >::value && is_nothrow_move_assignable<BST<WordPair> >::value,
+                  "moving a BST never throws");
+
+    BST<WordPair, UnbalancedPolicy, NewDeleteAllocator<WordPair> > empty;
+    BST<WordPair, UnbalancedPolicy, NewDeleteAllocator<WordPair> > emptyCopy(empty);
+    emptyCopy.insert(WordPair("leaf", "blad"));
+    empty = emptyCopy;
+    passed = passed && empty.getElementCount() == 1 && empty.retrieve(WordPair("leaf")).getTranslation() == "blad";
+
+    cout << "Copy and move test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testCopyAndMove
+
+// Checks that CompactWordPair orders and matches words exactly like WordPair
+void testCompactWordPair(BST<WordPair>* theTranslator) {
+    cout << "Test compact word pairs: " << endl;
+    bool passed = true;
+
+    vector<string> words = prefixEdgeWords();
+    for (size_t i = 0; i < words.size(); i++) {
+        CompactWordPair lhs(words[i], "translation");
+        passed = passed && lhs.getEnglish() == words[i] && lhs.getTranslation() == "translation";
+        for (size_t j = 0; j < words.size(); j++) {
+            CompactWordPair rhs(words[j]);
+            WordPair expectedLhs(words[i]);
+            WordPair expectedRhs(words[j]);
+            passed = passed && (lhs == rhs) == (expectedLhs == expectedRhs) && (lhs < rhs) == (expectedLhs < expectedRhs);
+            passed = passed && (lhs == string_view(words[j])) == (expectedLhs == words[j]);
+            passed = passed && (lhs < string_view(words[j])) == (expectedLhs < words[j]);
+            passed = passed && (lhs == WordPrefix(words[j])) == (expectedLhs == WordPrefix(words[j]));
+            passed = passed && (lhs < WordPrefix(words[j])) == (expectedLhs < WordPrefix(words[j]));
+            passed = passed && sign(lhs.compare(rhs)) == sign(expectedLhs.compare(expectedRhs));
+            passed = passed && sign(lhs.compare(WordPrefix(words[j]))) == sign(expectedLhs.compare(WordPrefix(words[j])));
+        }
+    }
+
+    // Same dictionary, same answers
+    vector<CompactWordPair> pairs;
+    for (BST<WordPair>::iterator it = theTranslator->begin(); it != theTranslator->end(); ++it)
+        pairs.push_back(CompactWordPair(*it));
+    BST<CompactWordPair> compact;
+    compact.buildFromSorted(pairs.begin(), pairs.end());
+    passed = passed && compact.getElementCount() == theTranslator->getElementCount();
+    passed = passed && compact.find("cloud") != NULL && compact.find("cloud")->getTranslation() == "sky" && !compact.contains("leaf");
+    passed = passed && compact.countRange(string_view("c"), string_view("d")) == theTranslator->countRange(string_view("c"), string_view("d"));
+    compact.find("cloud")->setTranslation("nuage");
+    passed = passed && compact.retrieve(CompactWordPair("cloud")).getTranslation() == "nuage";
+    cout << "Element size: " << sizeof(WordPair) << " bytes as WordPair, " << sizeof(CompactWordPair) << " bytes as CompactWordPair" << endl;
+
+    cout << "Compact word pair test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testCompactWordPair
+
+// In-order visitor for one reader thread: the writer only ever stores even
+// numbers, so a torn tree shows up as an unsorted or odd element
+struct SnapshotChecker {
+    int previous;
+    int count;
+    bool consistent;
+    SnapshotChecker() : previous(-1), count(0), consistent(true) {}
+    void operator()(const int& anElement) {
+        if (anElement <= previous || anElement % 2 != 0)
+            consistent = false;
+        previous = anElement;
+        count++;
+    }
+}; // end of SnapshotChecker
+
+// Readers look up and traverse a ConcurrentBST while one writer keeps changing it
+void testConcurrentReaders() {
+    cout << "Test concurrent readers: " << endl;
+    const int readerCount = 4;
+    const int keyRange = 2000;
+    ConcurrentBST<int> numbers;
+    atomic<bool> writerDone(false);
+    atomic<int> errors(0);
+    atomic<long> lookups(0);
+    atomic<long> traversals(0);
+
+    vector<thread> readers;
+    for (int r = 0; r < readerCount; r++) {
+        readers.push_back(thread([&, r]() {
+            unsigned int seed = r + 1;
+            while (!writerDone.load()) {
+                for (int i = 0; i < 100; i++) {
+                    int key = rand_r(&seed) % (2 * keyRange);
+                    int found = -1;
+                    if (numbers.retrieve(key, found) && found != key)
+                        errors++;
+                    if (key % 2 != 0 && numbers.contains(key))
+                        errors++;
+                }
+                lookups += 100;
+                SnapshotChecker checker;
+                numbers.traverseInOrder(checker);
+                if (!checker.consistent || checker.count > keyRange)
+                    errors++;
+                traversals++;
+            }
+        }));
+    }
+
+    srand(10);
+    for (int i = 0; i < 200000; i++) {
+        int key = 2 * (rand() % keyRange);
+        if (rand() % 2 == 0 && !numbers.contains(key))
+            numbers.insert(key);
+        else if (numbers.contains(key))
+            numbers.remove(key);
+    }
+    writerDone.store(true);
+    for (size_t r = 0; r < readers.size(); r++)
+        readers[r].join();
+
+    SnapshotChecker checker;
+    numbers.traverseInOrder(checker);
+    bool passed = errors.load() == 0 && checker.consistent && checker.count == numbers.getElementCount();
+    cout << readerCount << " readers: " << lookups.load() << " lookups, " << traversals.load()
+         << " traversals, " << errors.load() << " inconsistencies" << endl;
+
+    cout << "Concurrent readers test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testConcurrentReaders
+
+// Integer counting its live copies, which shows how many nodes the versions of
+// a PersistentBST hold between them
+struct TrackedInt {
+    static int live;
+    int value;
+    TrackedInt(int value) : value(value) { live++; }
+    TrackedInt(const TrackedInt& other) : value(other.value) { live++; }
+    ~TrackedInt() { live--; }
+    bool operator==(const TrackedInt& rhs) const { return value == rhs.value; }
+    bool operator<(const TrackedInt& rhs) const { return value < rhs.value; }
+}; // end of TrackedInt
+int TrackedInt::live = 0;
+
+// Checks that versions of a PersistentBST stay unchanged, share their nodes and
+// free them with the last version holding them
+void testPersistentBST(BST<WordPair>* theTranslator) {
+    cout << "Test persistent BST: " << endl;
+    bool passed = true;
+
+    {
+        PersistentBST<TrackedInt> numbers;
+        vector<PersistentBST<TrackedInt> > snapshots;
+        for (int i = 0; i < 1000; i++) {
+            if (i % 100 == 0)
+                snapshots.push_back(numbers);
+            numbers = numbers.insert(TrackedInt(i));
+        }
+        for (size_t v = 0; v < snapshots.size(); v++) {
+            int expected = 0;
+            snapshots[v].traverse([&](const TrackedInt& anElement) { passed = passed && anElement.value == expected++; });
+            passed = passed && expected == (int) v * 100 && snapshots[v].getElementCount() == expected;
+        }
+        snapshots.clear();
+        passed = passed && TrackedInt::live == 1000 && numbers.height() <= 15;
+
+        // A new version only adds the nodes of one path, rotations included
+        PersistentBST<TrackedInt> next = numbers.insert(TrackedInt(1000));
+        passed = passed && TrackedInt::live <= 1000 + 1 + numbers.height() + 2;
+        PersistentBST<TrackedInt> evens = numbers;
+        for (int i = 1; i < 1000; i += 2)
+            evens = evens.remove(TrackedInt(i));
+        passed = passed && evens.getElementCount() == 500 && numbers.getElementCount() == 1000 && next.getElementCount() == 1001;
+        passed = passed && evens.contains(TrackedInt(998)) && !evens.contains(TrackedInt(999)) && numbers.contains(TrackedInt(999));
+        passed = passed && evens.height() <= 13 && next.retrieve(TrackedInt(1000)).value == 1000;
+
+        int liveBefore = TrackedInt::live;
+        try {
+            evens.insert(TrackedInt(2));
+            passed = false;
+        } catch (ElementAlreadyExistsInBSTException& e) {
+        }
+        try {
+            evens.remove(TrackedInt(3));
+            passed = false;
+        } catch (ElementDoesNotExistInBSTException& e) {
+        }
+        passed = passed && TrackedInt::live == liveBefore;
+    }
+    passed = passed && TrackedInt::live == 0;
+
+    // A batch job reads its snapshot of the dictionary while updates go on
+    PersistentBST<WordPair> dictionary;
+    theTranslator->traverse([&](const WordPair& anElement) { dictionary = dictionary.insert(anElement); });
+    PersistentBST<WordPair> snapshot = dictionary;
+    atomic<int> errors(0);
+    thread batchJob([&]() {
+        for (int round = 0; round < 200; round++) {
+            int count = 0;
+            snapshot.traverse([&](const WordPair& anElement) { count++; });
+            if (count != theTranslator->getElementCount() || snapshot.find("cloud") == NULL || snapshot.contains("zebra"))
+                errors++;
+        }
+    });
+    for (int round = 0; round < 200; round++) {
+        dictionary = dictionary.insert(WordPair("zebra", "sebra")).remove(WordPair("cloud"));
+        dictionary = dictionary.insert(WordPair("cloud", "sky")).remove(WordPair("zebra"));
+    }
+    dictionary = dictionary.remove(WordPair("cloud"));
+    batchJob.join();
+    passed = passed && errors.load() == 0 && !dictionary.contains("cloud") && snapshot.find("cloud")->getTranslation() == "sky";
+
+    cout << "Persistent BST test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testPersistentBST
+
+// Checks that a HotKeyCache answers like the tree behind it, counts its hits and
+// misses and forgets its answers when the tree changes
+void testHotKeyCache(BST<WordPair>* theTranslator) {
+    cout << "Test hot key cache: " << endl;
+    bool passed = true;
+
+    BST<WordPair> dictionary(*theTranslator);
+    HotKeyCache<BST<WordPair> > cache(dictionary, 64);
+    passed = passed && cache.find("cloud") == dictionary.find("cloud") && cache.find("cloud") != NULL;
+    passed = passed && cache.find("zebra") == NULL && cache.find("zebra") == NULL;
+    passed = passed && cache.getHits() == 2 && cache.getMisses() == 2;
+
+    // Known misses and stale pointers are dropped by insert and remove
+    cache.insert(WordPair("zebra", "sebra"));
+    passed = passed && cache.find("zebra") != NULL && cache.find("zebra")->getTranslation() == "sebra";
+    cache.remove(WordPair("cloud"));
+    passed = passed && cache.find("cloud") == NULL && cache.find("tree") != NULL && cache.find("tree")->getTranslation() == "tre";
+    dictionary.insert(WordPair("cloud", "sky"));
+    cache.invalidate();
+    passed = passed && cache.find("cloud") != NULL;
+
+    // A skewed stream is answered from the cache, with the same answers as the tree
+    vector<string> words;
+    dictionary.traverse([&](const WordPair& anElement) { words.push_back(anElement.getEnglish()); });
+    words.push_back("unknown");
+    vector<string> queries;
+    for (int i = 0; i < 1000; i++)
+        queries.push_back(words[(i * i) % 7 == 0 ? i % words.size() : i % 3]);
+    cache.resetCounters();
+    vector<WordPair*> cached;
+    vector<WordPair*> expected;
+    int found = cache.retrieveBatch(queries, cached);
+    passed = passed && found == dictionary.retrieveBatch(queries, expected) && cached == expected;
+    passed = passed && cache.getHits() + cache.getMisses() == queries.size() && cache.getHits() > 800;
+
+    // With one slot every other word evicts the previous one, answers stay right
+    BTree<WordPair> wideDictionary;
+    wideDictionary.buildFromSorted(dictionary.begin(), dictionary.end());
+    HotKeyCache<BTree<WordPair> > tinyCache(wideDictionary, 1);
+    for (size_t i = 0; i < words.size(); i++) {
+        WordPair* answer = tinyCache.find(words[i]);
+        passed = passed && (answer == NULL ? words[i] == "unknown" : answer->getEnglish() == words[i]);
+    }
+    passed = passed && tinyCache.getHits() == 0;
+
+    cout << "Cache: " << cache.getHits() << " hits, " << cache.getMisses() << " misses" << endl;
+    cout << "Hot key cache test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testHotKeyCache
+
+// Element at the root and its children, read from a pre-order traversal: the left
+// child comes right after the root, the right child after the left subtree
+template <class Tree>
+bool nearRoot(const Tree& numbers, int value) {
+    vector<int> preOrder;
+    numbers.traverse([&](int anElement) { preOrder.push_back(anElement); }, PRE_ORDER);
+    int root = preOrder[0];
+    size_t rightChild = 1 + numbers.rank(root);
+    return root == value || (preOrder.size() > 1 && preOrder[1] < root && preOrder[1] == value)
+        || (rightChild < preOrder.size() && preOrder[rightChild] == value);
+} // end of nearRoot
+
+// Checks that splaying policies keep the tree and its sizes right, and that the
+// elements looked up move to the root (SplayPolicy) or close to it (SemiSplayPolicy)
+void testSplay(BST<WordPair>* theTranslator) {
+    cout << "Test splay policies: " << endl;
+    bool passed = true;
+
+    unsigned int seed = 25;
+    set<int> expected;
+    BST<int, SplayPolicy> splayed;
+    BST<int, SemiSplayPolicy> semiSplayed;
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < 300; i++) {
+            int value = rand_r(&seed) % 500;
+            if (expected.insert(value).second) {
+                splayed.insert(value);
+                semiSplayed.emplace(value);
+            } else {
+                try {
+                    splayed.emplace(value);
+                    passed = false;
+                } catch (ElementAlreadyExistsInBSTException&) {
+                }
+            }
+            int probe = rand_r(&seed) % 500;
+            passed = passed && splayed.contains(probe) == (expected.count(probe) == 1);
+            passed = passed && semiSplayed.contains(probe) == (expected.count(probe) == 1);
+        }
+        for (int i = 0; i < 200; i++) {
+            int value = rand_r(&seed) % 500;
+            if (expected.erase(value) == 1) {
+                splayed.remove(value);
+                semiSplayed.remove(value);
+            } else {
+                try {
+                    semiSplayed.remove(value);
+                    passed = false;
+                } catch (ElementDoesNotExistInBSTException&) {
+                }
+            }
+        }
+        passed = passed && checkOrderStatistics(splayed, expected) && checkOrderStatistics(semiSplayed, expected);
+        passed = passed && splayed.getElementCount() == (int) expected.size() && semiSplayed.getElementCount() == (int) expected.size();
+    }
+
+    // A lookup splays its element to the root, a semi-splayed one gets there within a few lookups
+    int hot = *expected.rbegin();
+    passed = passed && splayed.retrieve(hot) == hot;
+    vector<int> preOrder;
+    splayed.traverse([&](int anElement) { preOrder.push_back(anElement); }, PRE_ORDER);
+    passed = passed && preOrder[0] == hot;
+    for (int i = 0; i < 8; i++)
+        passed = passed && semiSplayed.find(hot) != NULL;
+    passed = passed && nearRoot(semiSplayed, hot);
+
+    // Sorted inserts leave a single path, which looking up its far end halves.
+    // Splaying brings the element to the root. Semi-splaying only lifts every
+    // other node of the path and leaves the element and the top of the path
+    // in place, then a few more lookups bring it up. Paths longer than the
+    // inline part of a BSTPath (64) are semi-splayed all the same.
+    for (int count : { 40, 2000 }) {
+        BST<int, SplayPolicy> path;
+        BST<int, SemiSplayPolicy> semiPath;
+        for (int i = 0; i < count; i++) {
+            path.insert(i);
+            semiPath.insert(i);
+        }
+        passed = passed && path.height() == count && semiPath.height() == count;
+        passed = passed && path.find(0) != NULL && semiPath.find(0) != NULL;
+        int splayRoot = -1;
+        int semiSplayRoot = -1;
+        path.traverse([&](int anElement) { splayRoot = anElement; return false; }, PRE_ORDER);
+        semiPath.traverse([&](int anElement) { semiSplayRoot = anElement; return false; }, PRE_ORDER);
+        cout << "Sorted " << count << " elements, after looking up the smallest: splay height "
+             << path.height() << ", root " << splayRoot << ", semi-splay height " << semiPath.height()
+             << ", root " << semiSplayRoot << endl;
+        passed = passed && path.height() <= count / 2 + 2 && semiPath.height() <= count / 2 + 2;
+        passed = passed && splayRoot == 0 && semiSplayRoot == count - 1 && !nearRoot(semiPath, 0);
+        for (int lookups = 0; lookups < 16 && !nearRoot(semiPath, 0); lookups++)
+            passed = passed && semiPath.contains(0);
+        set<int> all;
+        for (int i = 0; i < count; i++)
+            all.insert(i);
+        passed = passed && nearRoot(semiPath, 0) && checkOrderStatistics(semiPath, all);
+        BST<int, SplayPolicy> copy(path);
+        passed = passed && copy.height() == path.height() && copy.median() == (count - 1) / 2;
+    }
+
+    // A lookup restructures the tree under its iterators, so they are taken again
+    // after it; lower_bound leaves the tree as it is and can run during a scan
+    BST<int, SplayPolicy> small;
+    for (int i = 0; i < 10; i++)
+        small.insert(i);
+    vector<int> before;
+    small.traverse([&](int anElement) { before.push_back(anElement); }, PRE_ORDER);
+    vector<int> scanned;
+    for (BST<int, SplayPolicy>::iterator it = small.begin(); it != small.end(); ++it) {
+        scanned.push_back(*it);
+        passed = passed && *small.lower_bound(*it) == *it;
+    }
+    vector<int> after;
+    small.traverse([&](int anElement) { after.push_back(anElement); }, PRE_ORDER);
+    passed = passed && scanned.size() == 10 && is_sorted(scanned.begin(), scanned.end()) && after == before;
+    passed = passed && small.find(5) != NULL && nearRoot(small, 5);
+    after.clear();
+    small.traverse([&](int anElement) { after.push_back(anElement); }, PRE_ORDER);
+    passed = passed && after != before && after[0] == 5;
+    scanned.assign(small.begin(), small.end());
+    passed = passed && scanned.size() == 10 && is_sorted(scanned.begin(), scanned.end());
+
+    // Keys other than the element type, as with the default policy
+    BST<WordPair, SplayPolicy> dictionary;
+    theTranslator->traverse([&](const WordPair& anElement) { dictionary.insert(anElement); });
+    passed = passed && dictionary.getElementCount() == theTranslator->getElementCount();
+    string rootWord;
+    passed = passed && dictionary.find(string_view("cloud")) != NULL;
+    dictionary.traverse([&](const WordPair& anElement) { rootWord = anElement.getEnglish(); return false; }, PRE_ORDER);
+    passed = passed && rootWord == "cloud";
+    passed = passed && dictionary.contains(string_view("tree")) && !dictionary.contains(string_view("leaf"));
+
+    cout << "Splay test " << (passed ? "PASSED" : "FAILED") << endl;
+    cout << endl;
+} // end of testSplay
+
 int main() {
     BST<WordPair>* theTranslator = new BST<WordPair>();
 
@@ -38,13 +1241,12 @@ int main() {
             // cout << aLine << '\n';   // For debugging purposes
             pos = aLine.find(delimiter);
             englishW = aLine.substr(0, pos);
-            aLine.erase(0, pos + delimiter.length());
-            translationW = aLine;
+            translationW = aLine.substr(pos + delimiter.length());
             //cout << "Read: " << englishW << ":" << translationW << endl;  // For debugging purposes
-            WordPair aWordPair(englishW, translationW);
+            WordPair aWordPair(std::move(englishW), std::move(translationW));
             //cout << "Read: " <<  aWordPair.getEnglish() << ":" << aWordPair.getTranslation() << endl;  // For debugging purposes
             try {
-                theTranslator->insert(aWordPair);
+                theTranslator->insert(std::move(aWordPair));
             }
             catch (ElementAlreadyExistsInBSTException &anException) {
                 cout << anException.what() << " => " << aWordPair.getEnglish() << ":" << aWordPair.getTranslation()
@@ -100,7 +1302,27 @@ int main() {
         cout << endl;
 
         theTranslator->traverseInOrder(display);
+        cout << endl;
 
+        testBalancedShape(filename);
+        testBulkLoad();
+        testFreeze(theTranslator);
+        testBTree();
+        testConcurrentReaders();
+        testRetrieveBatch(theTranslator);
+        testMappedDictionary(theTranslator);
+        testParallelLoad(filename);
+        testRangeQueries(theTranslator);
+        testTraverse();
+        testOrderStatistics(theTranslator);
+        testSetOperations(theTranslator);
+        testCompactWordPair(theTranslator);
+        testThreeWayCompare();
+        testStats(theTranslator);
+        testCopyAndMove(theTranslator);
+        testPersistentBST(theTranslator);
+        testHotKeyCache(theTranslator);
+        testSplay(theTranslator);
 
 
     } else {
@@ -0,0 +1,428 @@
+/*
+ * BTree.cpp
+ * 
+ * Description: Data collection B-tree ADT class, an alternative backend to BST with
+ *              the same public interface.
+ *
+ * Class invariant: Every node but the root holds between NodeKeys / 2 and NodeKeys
+ *                  elements, all leaves are at the same depth, and an in-order
+ *                  walk visits the elements in increasing order.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#include "BTree.h"
+
+// Default Constructor
+template <class ElementType, int NodeKeys>
+BTree<ElementType, NodeKeys>::BTree() {
+    root = NULL;
+    elementCount = 0;
+}
+
+// Copy Constructor
+template <class ElementType, int NodeKeys>
+BTree<ElementType, NodeKeys>::BTree(const BTree& aBTree) {
+    root = (aBTree.root == NULL) ? NULL : copyR(aBTree.root);
+    elementCount = aBTree.elementCount;
+}
+
+//Description: Helper for copy, the recursion is only as deep as the tree is high
+template <class ElementType, int NodeKeys>
+typename BTree<ElementType, NodeKeys>::Node* BTree<ElementType, NodeKeys>::copyR(const Node* node) const {
+    Node* copy = new Node(node->leaf);
+    copy->keyCount = node->keyCount;
+    for (int i = 0; i < node->keyCount; i++)
+        copy->keys[i] = node->keys[i];
+    if (!node->isLeaf()) {
+        for (int i = 0; i <= node->keyCount; i++)
+            copy->children[i] = copyR(node->children[i]);
+    }
+    return copy;
+}
+
+// Destructor
+template <class ElementType, int NodeKeys>
+BTree<ElementType, NodeKeys>::~BTree() {
+    if (root != NULL)
+        deleteR(root);
+}
+
+//Description: Helper for destructor
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::deleteR(Node* node) {
+    if (!node->isLeaf()) {
+        for (int i = 0; i <= node->keyCount; i++)
+            deleteR(node->children[i]);
+    }
+    delete node;
+}
+
+// Description: Returns the number of elements in the BTree
+template <class ElementType, int NodeKeys>
+int BTree<ElementType, NodeKeys>::getElementCount() const {
+    return elementCount;
+}
+
+// Description: Inserts a new element into the BTree
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::insert(const ElementType& newElement) {
+    if (root == NULL)
+        root = new Node(true);
+    if (insertR(root, newElement)) {
+        Node* newRoot = new Node(false);
+        newRoot->children[0] = root;
+        root = newRoot;
+        splitChild(root, 0);
+    }
+    elementCount++;
+}
+
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::insert(ElementType&& newElement) {
+    if (root == NULL)
+        root = new Node(true);
+    if (insertR(root, std::move(newElement))) {
+        Node* newRoot = new Node(false);
+        newRoot->children[0] = root;
+        root = newRoot;
+        splitChild(root, 0);
+    }
+    elementCount++;
+}
+
+//Description: Helper for insert. Returns true when node overflowed and has to
+//             be split by its parent. Duplicates are detected on the way down,
+//             before anything is modified.
+template <class ElementType, int NodeKeys>
+template <class Element>
+bool BTree<ElementType, NodeKeys>::insertR(Node* node, Element&& element) {
+    int index = node->lowerBound(element);
+    if (node->hasKey(index, element)) {
+        throw ElementAlreadyExistsInBSTException("Element already present in BTree");
+    }
+
+    if (node->isLeaf()) {
+        for (int i = node->keyCount; i > index; i--)
+            node->keys[i] = std::move(node->keys[i - 1]);
+        node->keys[index] = std::forward<Element>(element);
+        node->keyCount++;
+    } else if (insertR(node->children[index], std::forward<Element>(element))) {
+        splitChild(node, index);
+    }
+    return node->keyCount > NodeKeys;
+}
+
+//Description: Splits the overflowing child at index into two nodes and moves
+//             its median element up into parent
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::splitChild(Node* parent, int index) {
+    Node* left = parent->children[index];
+    Node* right = new Node(left->leaf);
+    int median = left->keyCount / 2;
+
+    right->keyCount = left->keyCount - median - 1;
+    for (int i = 0; i < right->keyCount; i++)
+        right->keys[i] = std::move(left->keys[median + 1 + i]);
+    if (!left->isLeaf()) {
+        for (int i = 0; i <= right->keyCount; i++) {
+            right->children[i] = left->children[median + 1 + i];
+            left->children[median + 1 + i] = NULL;
+        }
+    }
+    left->keyCount = median;
+
+    for (int i = parent->keyCount; i > index; i--) {
+        parent->keys[i] = std::move(parent->keys[i - 1]);
+        parent->children[i + 1] = parent->children[i];
+    }
+    parent->keys[index] = std::move(left->keys[median]);
+    parent->children[index + 1] = right;
+    parent->keyCount++;
+}
+
+// Description: Replaces the content of the BTree with the sorted elements of [first, last)
+template <class ElementType, int NodeKeys>
+template <class ForwardIterator>
+void BTree<ElementType, NodeKeys>::buildFromSorted(ForwardIterator first, ForwardIterator last) {
+    if (root != NULL)
+        deleteR(root);
+    root = NULL;
+    elementCount = 0;
+
+    for (; first != last; ++first)
+        insert(*first);
+}
+
+// Description: Replaces the content of the BTree with the elements of [first, last)
+template <class ElementType, int NodeKeys>
+template <class InputIterator>
+int BTree<ElementType, NodeKeys>::buildFromUnsorted(InputIterator first, InputIterator last, vector<ElementType>* duplicates) {
+    if (root != NULL)
+        deleteR(root);
+    root = NULL;
+    elementCount = 0;
+
+    vector<ElementType> elements(first, last);
+    stable_sort(elements.begin(), elements.end());
+
+    // Equal elements are now adjacent, in their original order. Inserting in
+    // sorted order always descends along the rightmost path.
+    int duplicateCount = 0;
+    for (size_t i = 0; i < elements.size(); i++) {
+        if (i > 0 && elements[i - 1] == elements[i]) {
+            duplicateCount++;
+            if (duplicates != NULL)
+                duplicates->push_back(std::move(elements[i]));
+        } else {
+            insert(elements[i]);
+        }
+    }
+    return duplicateCount;
+}
+
+// Description: Retrieves a target element from the BTree
+template <class ElementType, int NodeKeys>
+ElementType& BTree<ElementType, NodeKeys>::retrieve(const ElementType& targetElement) const {
+    ElementType* found = find(targetElement);
+    if (found == NULL) {
+        throw ElementDoesNotExistInBSTException("Element not found in BTree");
+    }
+    return *found;
+}
+
+// Description: Returns a pointer to the element equal to key, NULL if there is none
+template <class ElementType, int NodeKeys>
+template <class Key>
+ElementType* BTree<ElementType, NodeKeys>::find(const Key& key) const {
+    Node* current = root;
+    while (current != NULL) {
+        int index = current->lowerBound(key);
+        if (current->hasKey(index, key))
+            return &current->keys[index];
+        current = current->isLeaf() ? NULL : current->children[index];
+    }
+    return NULL;
+}
+
+template <class ElementType, int NodeKeys>
+template <class Key>
+bool BTree<ElementType, NodeKeys>::contains(const Key& key) const {
+    return find(key) != NULL;
+}
+
+// Description: Looks up every key of keys, see BST::retrieveBatch
+template <class ElementType, int NodeKeys>
+template <class Key>
+int BTree<ElementType, NodeKeys>::retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results) const {
+    results.resize(keys.size());
+    int hits = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        results[i] = find(keys[i]);
+        if (results[i] != NULL)
+            hits++;
+    }
+    return hits;
+}
+
+// Description: traverse the BTree in order and "visit" each element
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::traverseInOrder(void visit(ElementType&)) const {
+    traverseInOrder<void (*)(ElementType&)>(visit);
+}
+
+// Description: Same as traverseInOrder above, for visitors that carry state
+template <class ElementType, int NodeKeys>
+template <class Visitor>
+void BTree<ElementType, NodeKeys>::traverseInOrder(Visitor& visitor) const {
+    traverse(visitor, IN_ORDER);
+}
+
+// Description: Visits the elements in the given order until the visitor returns false
+template <class ElementType, int NodeKeys>
+template <class Visitor>
+bool BTree<ElementType, NodeKeys>::traverse(Visitor&& visitor, TraversalOrder order) const {
+    return root == NULL || traverseR(visitor, root, order);
+}
+
+//Description: Helper for traverse, returns false once the visitor has stopped it
+template <class ElementType, int NodeKeys>
+template <class Visitor>
+bool BTree<ElementType, NodeKeys>::traverseR(Visitor& visitor, Node* node, TraversalOrder order) const {
+    if (order == PRE_ORDER) {
+        for (int i = 0; i < node->keyCount; i++) {
+            if (!visitElement(visitor, node->keys[i]))
+                return false;
+        }
+    }
+    for (int i = 0; i <= node->keyCount; i++) {
+        if (!node->isLeaf() && !traverseR(visitor, node->children[i], order))
+            return false;
+        if (order == IN_ORDER && i < node->keyCount && !visitElement(visitor, node->keys[i]))
+            return false;
+    }
+    if (order == POST_ORDER) {
+        for (int i = 0; i < node->keyCount; i++) {
+            if (!visitElement(visitor, node->keys[i]))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Description: Returns the number of levels (0 when empty)
+template <class ElementType, int NodeKeys>
+int BTree<ElementType, NodeKeys>::height() const {
+    int levels = 0;
+    for (Node* current = root; current != NULL; current = current->children[0])
+        levels++;
+    return levels;
+}
+
+// MIN / MAX
+template <class ElementType, int NodeKeys>
+ElementType& BTree<ElementType, NodeKeys>::min() const {
+    if (root == NULL) {
+        throw ElementDoesNotExistInBSTException("No Min element");
+    }
+    Node* current = root;
+    while (!current->isLeaf())
+        current = current->children[0];
+    return current->keys[0];
+}
+
+template <class ElementType, int NodeKeys>
+ElementType& BTree<ElementType, NodeKeys>::max() const {
+    if (root == NULL) {
+        throw ElementDoesNotExistInBSTException("No Max element");
+    }
+    Node* current = root;
+    while (!current->isLeaf())
+        current = current->children[current->keyCount];
+    return current->keys[current->keyCount - 1];
+}
+
+// Description: Removes a target element from the BTree
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::remove(const ElementType& targetElement) {
+    if (root == NULL || !removeR(root, targetElement)) {
+        throw ElementDoesNotExistInBSTException("Element not found");
+    }
+    elementCount--;
+
+    // The root may run out of elements: its only child takes its place
+    if (root->keyCount == 0) {
+        Node* oldRoot = root;
+        root = root->isLeaf() ? NULL : root->children[0];
+        delete oldRoot;
+    }
+}
+
+//Description: Helper for remove. Returns true if target was found and removed.
+template <class ElementType, int NodeKeys>
+bool BTree<ElementType, NodeKeys>::removeR(Node* node, const ElementType& target) {
+    int index = node->lowerBound(target);
+    bool found = node->hasKey(index, target);
+
+    if (node->isLeaf()) {
+        if (!found)
+            return false;
+        for (int i = index; i < node->keyCount - 1; i++)
+            node->keys[i] = std::move(node->keys[i + 1]);
+        node->keyCount--;
+        return true;
+    }
+
+    if (found) {
+        // the in-order predecessor takes the place of target
+        node->keys[index] = removeMaxR(node->children[index]);
+    } else if (!removeR(node->children[index], target)) {
+        return false;
+    }
+    fixChild(node, index);
+    return true;
+}
+
+//Description: Removes the largest element of the subtree and returns it
+template <class ElementType, int NodeKeys>
+ElementType BTree<ElementType, NodeKeys>::removeMaxR(Node* node) {
+    if (node->isLeaf()) {
+        node->keyCount--;
+        return std::move(node->keys[node->keyCount]);
+    }
+    ElementType max = removeMaxR(node->children[node->keyCount]);
+    fixChild(node, node->keyCount);
+    return max;
+}
+
+//Description: Refills the child at index if it fell below MIN_KEYS, by
+//             borrowing from a sibling or merging with one
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::fixChild(Node* parent, int index) {
+    Node* child = parent->children[index];
+    if (child->keyCount >= MIN_KEYS)
+        return;
+
+    Node* leftSibling = (index > 0) ? parent->children[index - 1] : NULL;
+    Node* rightSibling = (index < parent->keyCount) ? parent->children[index + 1] : NULL;
+
+    if (leftSibling != NULL && leftSibling->keyCount > MIN_KEYS) {
+        // rotate the separator down into child and the left sibling's max up
+        for (int i = child->keyCount; i > 0; i--)
+            child->keys[i] = std::move(child->keys[i - 1]);
+        if (!child->isLeaf()) {
+            for (int i = child->keyCount + 1; i > 0; i--)
+                child->children[i] = child->children[i - 1];
+            child->children[0] = leftSibling->children[leftSibling->keyCount];
+            leftSibling->children[leftSibling->keyCount] = NULL;
+        }
+        child->keys[0] = std::move(parent->keys[index - 1]);
+        child->keyCount++;
+        leftSibling->keyCount--;
+        parent->keys[index - 1] = std::move(leftSibling->keys[leftSibling->keyCount]);
+    } else if (rightSibling != NULL && rightSibling->keyCount > MIN_KEYS) {
+        // rotate the separator down into child and the right sibling's min up
+        child->keys[child->keyCount] = std::move(parent->keys[index]);
+        child->keyCount++;
+        parent->keys[index] = std::move(rightSibling->keys[0]);
+        if (!child->isLeaf())
+            child->children[child->keyCount] = rightSibling->children[0];
+        for (int i = 0; i < rightSibling->keyCount - 1; i++)
+            rightSibling->keys[i] = std::move(rightSibling->keys[i + 1]);
+        if (!rightSibling->isLeaf()) {
+            for (int i = 0; i < rightSibling->keyCount; i++)
+                rightSibling->children[i] = rightSibling->children[i + 1];
+            rightSibling->children[rightSibling->keyCount] = NULL;
+        }
+        rightSibling->keyCount--;
+    } else if (leftSibling != NULL) {
+        mergeChildren(parent, index - 1);
+    } else {
+        mergeChildren(parent, index);
+    }
+}
+
+//Description: Merges the child at index + 1 and the separating element into the
+//             child at index
+template <class ElementType, int NodeKeys>
+void BTree<ElementType, NodeKeys>::mergeChildren(Node* parent, int index) {
+    Node* left = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    left->keys[left->keyCount] = std::move(parent->keys[index]);
+    for (int i = 0; i < right->keyCount; i++)
+        left->keys[left->keyCount + 1 + i] = std::move(right->keys[i]);
+    if (!left->isLeaf()) {
+        for (int i = 0; i <= right->keyCount; i++)
+            left->children[left->keyCount + 1 + i] = right->children[i];
+    }
+    left->keyCount += 1 + right->keyCount;
+
+    for (int i = index; i < parent->keyCount - 1; i++) {
+        parent->keys[i] = std::move(parent->keys[i + 1]);
+        parent->children[i + 1] = parent->children[i + 2];
+    }
+    parent->children[parent->keyCount] = NULL;
+    parent->keyCount--;
+    delete right;
+}
@@ -0,0 +1,154 @@
+/*
+ * BTree.h
+ * 
+ * Description: Data collection B-tree ADT class, an alternative backend to BST with
+ *              the same public interface. Every node holds up to NodeKeys sorted
+ *              elements, so a lookup visits log(NodeKeys + 1) n nodes instead of
+ *              log2 n and touches contiguous memory within each one.
+ *
+ * Class invariant: Every node but the root holds between NodeKeys / 2 and NodeKeys
+ *                  elements, all leaves are at the same depth, and an in-order
+ *                  walk visits the elements in increasing order.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "BTreeNode.h"
+#include "Traversal.h"
+#include "ElementAlreadyExistsInBSTException.h"
+#include "ElementDoesNotExistInBSTException.h"
+
+
+template <class ElementType, int NodeKeys = defaultBTreeNodeKeys<ElementType>()>
+class BTree {
+
+	static_assert(NodeKeys >= 3, "a B-tree node needs room for at least 3 keys");
+
+private:
+
+	typedef BTreeNode<ElementType, NodeKeys> Node;
+
+	// Fewest elements a node other than the root may hold
+	static const int MIN_KEYS = NodeKeys / 2;
+
+	Node* root;
+	int elementCount;
+
+    //Description: Helper for insert. Returns true when node overflowed and has to
+    //             be split by its parent.
+    template <class Element>
+    bool insertR(Node* node, Element&& element); // throw(ElementAlreadyExistsInBSTException);
+
+    //Description: Splits the overflowing child at index into two nodes and moves
+    //             its median element up into parent
+    void splitChild(Node* parent, int index);
+
+    //Description: Helper for remove. Returns true if target was found and removed.
+    bool removeR(Node* node, const ElementType& target);
+
+    //Description: Removes the largest element of the subtree and returns it
+    ElementType removeMaxR(Node* node);
+
+    //Description: Refills the child at index if it fell below MIN_KEYS, by
+    //             borrowing from a sibling or merging with one
+    void fixChild(Node* parent, int index);
+
+    //Description: Merges the child at index + 1 and the separating element into the
+    //             child at index
+    void mergeChildren(Node* parent, int index);
+
+    //Description: Helpers for traverse, copy and destructor
+    template <class Visitor>
+    bool traverseR(Visitor& visitor, Node* node, TraversalOrder order) const;
+    Node* copyR(const Node* node) const;
+    void deleteR(Node* node);
+
+public:
+
+    // Constructors and destructor:
+	BTree();                             // Default constructor
+	BTree(const BTree& aBTree);          // Copy constructor 
+    ~BTree();                            // Destructor 
+
+    BTree& operator=(const BTree&) = delete;
+
+    // BTree operations:
+
+    // Description: Returns the number of elements in the BTree
+    // Time efficiency: O(1)
+	int getElementCount() const;
+
+    // Description: Inserts a new element into the BTree
+	// Time efficiency: O(log n)
+    // Pre Condition: Element not already in BTree
+    // Post Condition: Element count incremented by 1
+	void insert(const ElementType& newElement); // throw(ElementAlreadyExistsInBSTException);
+	void insert(ElementType&& newElement); // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Replaces the content of the BTree with the elements of
+    //              [first, last), which only ever descends the rightmost path
+    // Pre Condition: [first, last) is sorted and holds no duplicates
+	// Time efficiency: O(n log n)
+	template <class ForwardIterator>
+	void buildFromSorted(ForwardIterator first, ForwardIterator last);
+
+    // Description: Replaces the content of the BTree with the elements of
+    //              [first, last), see BST::buildFromUnsorted
+	// Time efficiency: O(n log n)
+	template <class InputIterator>
+	int buildFromUnsorted(InputIterator first, InputIterator last, vector<ElementType>* duplicates = NULL);
+
+    // Description: Retrieves a target element from the BTree
+	// Time efficiency: O(log n)
+	ElementType& retrieve(const ElementType& targetElement) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns a pointer to the element equal to key, NULL if there is none.
+    //              Key is ElementType or any type it compares with through == and <.
+	// Time efficiency: O(log n)
+	template <class Key>
+	ElementType* find(const Key& key) const;
+
+	template <class Key>
+	bool contains(const Key& key) const;
+
+    // Description: Looks up every key of keys, see BST::retrieveBatch. The nodes
+    //              are wide enough that one lookup at a time is kept here.
+	// Time efficiency: O(k log n) for k keys
+	template <class Key>
+	int retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results) const;
+
+    // Description: traverse the BTree in order and "visit" each element
+	// Time efficiency: O(n)
+	void traverseInOrder(void visit(ElementType&)) const;
+
+    // Description: Same as traverseInOrder above, for visitors that carry state
+	template <class Visitor>
+	void traverseInOrder(Visitor& visitor) const;
+
+    // Description: Visits the elements with any callable, see BST::traverse. In
+    //              PRE_ORDER every element of a node comes before its children, in
+    //              POST_ORDER after them.
+	// Time efficiency: O(n)
+	template <class Visitor>
+	bool traverse(Visitor&& visitor, TraversalOrder order = IN_ORDER) const;
+
+    // Description: Returns the number of levels (0 when empty)
+    // Time efficiency: O(log n)
+    int height() const;
+
+	ElementType& min() const; // throw(ElementDoesNotExistInBSTException);
+	ElementType& max() const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Removes a target element from the BTree
+	// Time efficiency: O(log n)
+	void remove(const ElementType& targetElement); // throw(ElementDoesNotExistInBSTException);
+	
+}; // end BTree
+
+#include "BTree.cpp"
@@ -0,0 +1,54 @@
+/*
+ * BTreeNode.cpp
+ * 
+ * Description: Models a wide node of a B-tree: up to NodeKeys sorted elements
+ *              and, for internal nodes, one more child than elements.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "BTreeNode.h"
+
+
+// Constructor
+template <class ElementType, int NodeKeys>
+BTreeNode<ElementType, NodeKeys>::BTreeNode(bool leaf) {
+	keyCount = 0;
+	this->leaf = leaf;
+	for (int i = 0; i < NodeKeys + 2; i++)
+		children[i] = NULL;
+}
+
+template <class ElementType, int NodeKeys>
+template <class Key>
+int BTreeNode<ElementType, NodeKeys>::lowerBound(const Key& key) const {
+	if constexpr (is_arithmetic<ElementType>::value && is_arithmetic<Key>::value) {
+		int count = 0;
+		for (int i = 0; i < keyCount; i++)
+			count += (keys[i] < key);
+		return count;
+	} else {
+		int low = 0;
+		int high = keyCount;
+		while (low < high) {
+			int middle = (low + high) / 2;
+			if (keys[middle] < key)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		return low;
+	}
+}
+
+// Boolean helper functions
+template <class ElementType, int NodeKeys>
+bool BTreeNode<ElementType, NodeKeys>::isLeaf() const {
+	return leaf;
+}
+
+template <class ElementType, int NodeKeys>
+template <class Key>
+bool BTreeNode<ElementType, NodeKeys>::hasKey(int index, const Key& key) const {
+	return index < keyCount && keys[index] == key;
+}
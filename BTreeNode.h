@@ -0,0 +1,53 @@
+/*
+ * BTreeNode.h
+ * 
+ * Description: Models a wide node of a B-tree: up to NodeKeys sorted elements
+ *              and, for internal nodes, one more child than elements.
+ *              The elements of children[i] are all less than keys[i], those of
+ *              children[i + 1] all greater.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+using namespace std;
+
+// Description: Default number of keys per node, two cache lines of keys (the
+//              fastest lookups for 4M int keys) and never fewer than 8
+template <class ElementType>
+constexpr int defaultBTreeNodeKeys() {
+    return (sizeof(ElementType) * 8 >= 128) ? 8 : (int) (128 / sizeof(ElementType));
+}
+
+template <class ElementType, int NodeKeys>
+class BTreeNode {
+
+public:
+
+    int keyCount;
+    bool leaf;
+    ElementType keys[NodeKeys + 1];                         // One spare slot holds the overflow until the node is split
+    BTreeNode<ElementType, NodeKeys>* children[NodeKeys + 2];
+
+    // Constructor
+    BTreeNode(bool leaf) ;
+
+    // Description: Number of keys less than key, i.e. the index of the first key
+    //              not less than key, or of the child to descend into.
+    //              Counted without branches for arithmetic keys, which lets the
+    //              compiler vectorize the scan, binary search otherwise.
+    template <class Key>
+    int lowerBound(const Key& key) const;
+
+    // Boolean helper functions
+    bool isLeaf() const;
+    template <class Key>
+    bool hasKey(int index, const Key& key) const;
+
+};
+
+#include "BTreeNode.cpp"
@@ -0,0 +1,237 @@
+/*
+ * BalancePolicy.cpp
+ *
+ * Description: Balancing policies for the BST ADT class, selected through
+ *              its second template parameter.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "BalancePolicy.h"
+
+
+// UNBALANCED
+template <class ElementType>
+void UnbalancedPolicy::rebalance(BSTNode<ElementType>*& current) {
+}
+
+
+// AVL
+template <class ElementType>
+int AVLPolicy::height(const BSTNode<ElementType>* current) {
+    return (current == NULL) ? 0 : current->height;
+}
+
+template <class ElementType>
+void AVLPolicy::updateHeight(BSTNode<ElementType>* current) {
+    int leftHeight = height(current->left);
+    int rightHeight = height(current->right);
+    current->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+template <class ElementType>
+void AVLPolicy::rotateLeft(BSTNode<ElementType>*& current) {
+    BSTNode<ElementType>* pivot = current->right;
+    current->right = pivot->left;
+    pivot->left = current;
+    updateHeight(current);
+    updateHeight(pivot);
+    current->updateSize();
+    pivot->updateSize();
+    current = pivot;
+}
+
+template <class ElementType>
+void AVLPolicy::rotateRight(BSTNode<ElementType>*& current) {
+    BSTNode<ElementType>* pivot = current->left;
+    current->left = pivot->right;
+    pivot->right = current;
+    updateHeight(current);
+    updateHeight(pivot);
+    current->updateSize();
+    pivot->updateSize();
+    current = pivot;
+}
+
+template <class ElementType>
+void AVLPolicy::rebalance(BSTNode<ElementType>*& current) {
+
+    int balance = height(current->left) - height(current->right);
+
+    if (balance > 1) {          // left heavy
+        if (height(current->left->left) < height(current->left->right))
+            rotateLeft(current->left);
+        rotateRight(current);
+    } else if (balance < -1) {  // right heavy
+        if (height(current->right->right) < height(current->right->left))
+            rotateRight(current->right);
+        rotateLeft(current);
+    } else {
+        updateHeight(current);
+    }
+}
+
+
+// SPLAY
+template <class ElementType>
+void SplayPolicy::rotateLeft(BSTNode<ElementType>*& current) {
+    BSTNode<ElementType>* pivot = current->right;
+    current->right = pivot->left;
+    pivot->left = current;
+    current->updateSize();
+    pivot->updateSize();
+    current = pivot;
+}
+
+template <class ElementType>
+void SplayPolicy::rotateRight(BSTNode<ElementType>*& current) {
+    BSTNode<ElementType>* pivot = current->left;
+    current->left = pivot->right;
+    pivot->right = current;
+    current->updateSize();
+    pivot->updateSize();
+    current = pivot;
+}
+
+template <class ElementType>
+void SplayPolicy::rebalance(BSTNode<ElementType>*& current) {
+}
+
+// Sleator and Tarjan's top-down splay. The nodes passed on the way down are hung
+// from two trees, less holding those less than the key along its right spine and
+// greater those greater along its left spine, which become the subtrees of the
+// node the descent stops at. Only the spines need their sizes fixed afterwards.
+template <class ElementType, class Key>
+int SplayPolicy::splay(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth) {
+
+    depth = 0;
+    BSTNode<ElementType>* current = root;
+    if (current == NULL)
+        return 1;
+
+    BSTNode<ElementType>* less = NULL;
+    BSTNode<ElementType>* greater = NULL;
+    BSTNode<ElementType>** lessLink = &less;        // right link of the largest node in less
+    BSTNode<ElementType>** greaterLink = &greater;  // left link of the smallest node in greater
+    int lessSize = 0;
+    int greaterSize = 0;
+
+    int order = searchKey.compare(current);
+    depth++;
+    while (order != 0) {
+        if (order > 0) {            // key in the left subtree
+            if (current->left == NULL)
+                break;
+            int childOrder = searchKey.compare(current->left);
+            depth++;
+            if (childOrder > 0) {   // zig-zig: rotate right first
+                rotateRight(current);
+                order = childOrder;
+                if (current->left == NULL)
+                    break;
+                childOrder = searchKey.compare(current->left);
+                depth++;
+            }
+            *greaterLink = current;
+            greaterLink = &current->left;
+            greaterSize += 1 + current->rightSize();
+            current = current->left;
+            order = childOrder;
+        } else {                    // key in the right subtree
+            if (current->right == NULL)
+                break;
+            int childOrder = searchKey.compare(current->right);
+            depth++;
+            if (childOrder < 0) {   // zig-zig: rotate left first
+                rotateLeft(current);
+                order = childOrder;
+                if (current->right == NULL)
+                    break;
+                childOrder = searchKey.compare(current->right);
+                depth++;
+            }
+            *lessLink = current;
+            lessLink = &current->right;
+            lessSize += 1 + current->leftSize();
+            current = current->right;
+            order = childOrder;
+        }
+    }
+
+    // Sizes of the spines, top-down: each node holds what remains below it
+    lessSize += current->leftSize();
+    greaterSize += current->rightSize();
+    current->size = lessSize + greaterSize + 1;
+    *lessLink = NULL;
+    *greaterLink = NULL;
+    for (BSTNode<ElementType>* spine = less; spine != NULL; spine = spine->right) {
+        spine->size = lessSize;
+        lessSize -= 1 + spine->leftSize();
+    }
+    for (BSTNode<ElementType>* spine = greater; spine != NULL; spine = spine->left) {
+        spine->size = greaterSize;
+        greaterSize -= 1 + spine->rightSize();
+    }
+
+    *lessLink = current->left;
+    *greaterLink = current->right;
+    current->left = less;
+    current->right = greater;
+    root = current;
+    return order;
+}
+
+template <class ElementType, class Key>
+BSTNode<ElementType>* SplayPolicy::access(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth) {
+    return (splay(root, searchKey, depth) == 0) ? root : NULL;
+}
+
+
+// SEMI-SPLAY
+template <class ElementType, class Key>
+BSTNode<ElementType>* SemiSplayPolicy::access(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth) {
+
+    // path[i] is the link holding the node compared at depth i + 1. Lookups do
+    // not throw: if a deep path cannot grow, the tree is splayed, which needs
+    // no memory, instead of semi-splayed.
+    BSTPath<ElementType> path;
+    BSTNode<ElementType>** link = &root;
+    depth = 0;
+    int order = 1;
+    try {
+        while (*link != NULL) {
+            path.push(link);
+            depth++;
+            order = searchKey.compare(*link);
+            if (order == 0)
+                break;
+            link = (order < 0) ? &(*link)->right : &(*link)->left;
+        }
+    } catch (bad_alloc&) {
+        return SplayPolicy::access(root, searchKey, depth);
+    }
+    BSTNode<ElementType>* found = (order == 0) ? *path[depth - 1] : NULL;
+
+    // Each step rotates at the grandparent of the node climbing, which is
+    // left at depth i; the final single rotation of a splay is skipped
+    for (int i = depth - 1; i >= 2; i -= 2) {
+        BSTNode<ElementType>* parent = *path[i - 1];
+        bool onLeft = (parent->left == *path[i]);
+        bool parentOnLeft = ((*path[i - 2])->left == parent);
+        if (onLeft == parentOnLeft) {       // zig-zig: the parent climbs, then goes on
+            if (parentOnLeft)
+                rotateRight(*path[i - 2]);
+            else
+                rotateLeft(*path[i - 2]);
+        } else {                            // zig-zag: the node climbs over both
+            if (parentOnLeft) {
+                rotateLeft(*path[i - 1]);
+                rotateRight(*path[i - 2]);
+            } else {
+                rotateRight(*path[i - 1]);
+                rotateLeft(*path[i - 2]);
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,143 @@
+/*
+ * BalancePolicy.h
+ *
+ * Description: Balancing policies for the BST ADT class, selected through
+ *              its second template parameter.
+ *
+ *              UnbalancedPolicy - plain BST, the shape depends on insertion order.
+ *              AVLPolicy        - AVL tree, the height of every subtree stays
+ *                                 within 1.44 log2(n + 2).
+ *              SplayPolicy      - splay tree, every insert, remove, retrieve, find
+ *                                 and contains moves the element it reaches to the
+ *                                 root, so a sequence of m operations costs
+ *                                 O(m log2 n) and often-used elements stay near the top.
+ *              SemiSplayPolicy  - same, except that lookups only semi-splay: the
+ *                                 element reached climbs about half way up, its
+ *                                 path is halved in length, and a lookup rewrites
+ *                                 roughly half as many links.
+ *
+ *              A policy exposes rebalance(current), which the BST calls on every
+ *              node of the path it modified, bottom-up, after an insert or a remove,
+ *              and the flag rebalancing, which tells the BST whether there is
+ *              anything to restore at all.
+ *
+ *              A splaying policy instead restructures the tree from the root, through
+ *              splay(root, searchKey, depth) for inserts and removes and through
+ *              access(root, searchKey, depth) for lookups, and sets the flag splaying.
+ *              Lookups then change the tree: a splaying BST must not be read from
+ *              several threads at once, and a lookup invalidates its iterators.
+ *              Queries that do not look up a single element (retrieveBatch, order
+ *              statistics, ranges, traversals) leave it as it is.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <new>
+#include "BSTNode.h"
+
+
+class UnbalancedPolicy {
+
+public:
+
+    static const bool rebalancing = false;
+    static const bool splaying = false;
+
+    // Description: Nothing to restore, the tree keeps whatever shape it was given
+    template <class ElementType>
+    static void rebalance(BSTNode<ElementType>*& current);
+
+}; // end UnbalancedPolicy
+
+
+class AVLPolicy {
+
+private:
+
+    // Description: Height of a possibly empty subtree
+    template <class ElementType>
+    static int height(const BSTNode<ElementType>* current);
+
+    // Description: Recomputes the height of current from its children
+    template <class ElementType>
+    static void updateHeight(BSTNode<ElementType>* current);
+
+    template <class ElementType>
+    static void rotateLeft(BSTNode<ElementType>*& current);
+
+    template <class ElementType>
+    static void rotateRight(BSTNode<ElementType>*& current);
+
+public:
+
+    static const bool rebalancing = true;
+    static const bool splaying = false;
+
+    // Description: Updates the height of current and rotates it back into
+    //              AVL shape if its subtrees differ in height by 2
+    // Pre Condition: Both subtrees of current are AVL trees
+    // Time efficiency: O(1)
+    template <class ElementType>
+    static void rebalance(BSTNode<ElementType>*& current);
+
+}; // end AVLPolicy
+
+
+class SplayPolicy {
+
+protected:
+
+    // Rotations keep the subtree sizes up to date; splay trees have no use for heights
+    template <class ElementType>
+    static void rotateLeft(BSTNode<ElementType>*& current);
+
+    template <class ElementType>
+    static void rotateRight(BSTNode<ElementType>*& current);
+
+public:
+
+    static const bool rebalancing = false;
+    static const bool splaying = true;
+
+    // Description: Nothing to do bottom-up, splaying already reshaped the tree
+    template <class ElementType>
+    static void rebalance(BSTNode<ElementType>*& current);
+
+    // Description: Top-down splay. Restructures the subtree under root so that the
+    //              node equal to the key, or else the last node compared on the way
+    //              to it (its predecessor or successor), becomes its root. Sets
+    //              depth to the number of nodes compared and returns the order of
+    //              the new root relative to the key, as SearchKey::compare: 0 if it
+    //              is equal, nonzero if it is not or if the subtree is empty.
+    // Time efficiency: O(log2 n) amortized, O(1) extra space
+    template <class ElementType, class Key>
+    static int splay(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth);
+
+    // Description: Looks the key up for retrieve, find and contains, splaying the
+    //              tree. Returns the node equal to the key, NULL if there is none.
+    // Time efficiency: O(log2 n) amortized
+    template <class ElementType, class Key>
+    static BSTNode<ElementType>* access(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth);
+
+}; // end SplayPolicy
+
+
+// Inserts and removes splay as with SplayPolicy, lookups semi-splay
+class SemiSplayPolicy : public SplayPolicy {
+
+public:
+
+    // Description: Looks the key up, then semi-splays the last node compared: where
+    //              it and its parent hang on the same side, only the parent is rotated
+    //              up and the climb goes on from the parent, so every node of the path
+    //              ends about half as deep as it was. Returns the node equal to the
+    //              key, NULL if there is none.
+    // Time efficiency: O(log2 n) amortized
+    template <class ElementType, class Key>
+    static BSTNode<ElementType>* access(BSTNode<ElementType>*& root, const SearchKey<ElementType, Key>& searchKey, int& depth);
+
+}; // end SemiSplayPolicy
+
+#include "BalancePolicy.cpp"
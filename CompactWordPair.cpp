@@ -0,0 +1,129 @@
+/*
+ * CompactWordPair.cpp
+ *
+ * Description: Models an English word and its translation in another language,
+ *              both stored in a shared StringArena.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <cstring>
+#include "CompactWordPair.h"
+
+static const size_t PREFIX_LENGTH = sizeof(uint64_t);
+
+// Constructors
+CompactWordPair::CompactWordPair() {
+	assign(string_view(), string_view());
+}
+
+CompactWordPair::CompactWordPair(string_view english) {
+	assign(english, string_view());
+}
+
+CompactWordPair::CompactWordPair(string_view english, string_view translation) {
+	assign(english, translation);
+}
+
+CompactWordPair::CompactWordPair(const WordPair& aWordPair) {
+	assign(aWordPair.getEnglish(), aWordPair.getTranslation());
+}
+
+StringArena& CompactWordPair::arena() {
+	static StringArena theArena;
+	return theArena;
+}
+
+//Description: Stores english and translation in the arena and points to them
+void CompactWordPair::assign(string_view english, string_view translation) {
+	text = arena().store(english, translation);
+	englishLength = (uint32_t) english.size();
+	translationLength = (uint32_t) translation.size();
+	prefix = bigEndianPrefix(english);
+}
+
+//Description: Three-way comparison of the English word with word
+int CompactWordPair::compareEnglish(string_view word, uint64_t wordPrefix) const {
+	if (prefix != wordPrefix)
+		return (prefix < wordPrefix) ? -1 : 1;
+	// Equal prefixes of two words that fit in them: the shorter one is less
+	if (englishLength <= PREFIX_LENGTH && word.size() <= PREFIX_LENGTH)
+		return (englishLength < word.size()) ? -1 : (englishLength > word.size());
+	return getEnglish().compare(word);
+}
+
+// Getters
+string_view CompactWordPair::getEnglish() const {
+	return string_view(text, englishLength);
+}
+
+string_view CompactWordPair::getTranslation() const {
+	return string_view(text + englishLength, translationLength);
+}
+
+// Setters
+void CompactWordPair::setEnglish(string_view english) {
+	assign(english, getTranslation());
+}
+
+void CompactWordPair::setTranslation(string_view translation) {
+	assign(getEnglish(), translation);
+}
+
+// Overloaded Operators
+bool CompactWordPair::operator==(const CompactWordPair& rhs) const {
+
+	return prefix == rhs.prefix && englishLength == rhs.englishLength
+	       && (englishLength <= PREFIX_LENGTH
+	           || memcmp(text + PREFIX_LENGTH, rhs.text + PREFIX_LENGTH, englishLength - PREFIX_LENGTH) == 0);
+} // end of operator==
+
+bool CompactWordPair::operator<(const CompactWordPair& rhs) const {
+
+	if (prefix != rhs.prefix)
+		return prefix < rhs.prefix;
+	return compareEnglish(rhs.getEnglish(), rhs.prefix) < 0;
+} // end of operator<
+
+bool CompactWordPair::operator==(string_view rhs) const {
+
+	return englishLength == rhs.size() && compareEnglish(rhs, bigEndianPrefix(rhs)) == 0;
+} // end of operator==
+
+bool CompactWordPair::operator<(string_view rhs) const {
+
+	return compareEnglish(rhs, bigEndianPrefix(rhs)) < 0;
+} // end of operator<
+
+bool CompactWordPair::operator==(const WordPrefix& rhs) const {
+
+	if (rhs.prefix.size() <= PREFIX_LENGTH) {
+		// Only the leading bytes covered by the prefix have to match
+		uint64_t mask = (rhs.prefix.empty()) ? 0 : ~(uint64_t) 0 << (8 * (PREFIX_LENGTH - rhs.prefix.size()));
+		return englishLength >= rhs.prefix.size() && ((prefix ^ bigEndianPrefix(rhs.prefix)) & mask) == 0;
+	}
+	return getEnglish().compare(0, rhs.prefix.size(), rhs.prefix) == 0;
+} // end of operator==
+
+bool CompactWordPair::operator<(const WordPrefix& rhs) const {
+
+	// A word starting with the prefix is never less than it
+	return compareEnglish(rhs.prefix, bigEndianPrefix(rhs.prefix)) < 0;
+} // end of operator<
+
+int CompactWordPair::compare(const CompactWordPair& rhs) const {
+
+	if (prefix != rhs.prefix)
+		return (prefix < rhs.prefix) ? -1 : 1;
+	return compareEnglish(rhs.getEnglish(), rhs.prefix);
+} // end of compare
+
+int CompactWordPair::compare(string_view rhs) const {
+
+	return compareEnglish(rhs, bigEndianPrefix(rhs));
+} // end of compare
+
+int CompactWordPair::compare(const WordPrefix& rhs) const {
+
+	return (*this == rhs) ? 0 : compare(rhs.prefix);
+} // end of compare
@@ -0,0 +1,84 @@
+/*
+ * CompactWordPair.h
+ *
+ * Description: Same English word and translation as WordPair, in 24 bytes and
+ *              without a heap allocation of its own. Both strings are copied
+ *              once into a StringArena shared by every CompactWordPair, English
+ *              word first, and the element keeps where they start and how long
+ *              they are.
+ *
+ *              The first 8 bytes of the English word are also kept in the
+ *              element, as one big-endian integer, so most comparisons are
+ *              settled by a single integer compare without reading the arena.
+ *
+ *              Copies share the stored strings, and the arena keeps them until
+ *              the program ends: it suits a dictionary that is built once and
+ *              mostly read, not one whose words keep being replaced.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include "KeyPrefix.h"
+#include "StringArena.h"
+#include "WordPair.h"
+
+using namespace std;
+
+
+class CompactWordPair {
+
+private:
+
+	uint64_t prefix;              // first 8 bytes of english, big-endian, zero padded
+	const char* text;             // english immediately followed by translation, in the arena
+	uint32_t englishLength;
+	uint32_t translationLength;
+
+	//Description: Three-way comparison of the English word with word, whose prefix is wordPrefix
+	int compareEnglish(string_view word, uint64_t wordPrefix) const;
+
+	//Description: Stores english and translation in the arena and points to them
+	void assign(string_view english, string_view translation);
+
+public:
+
+	// Description: Arena holding the strings of every CompactWordPair
+	static StringArena& arena();
+
+	// Constructors
+	CompactWordPair() ;
+	explicit CompactWordPair(string_view english) ;
+	CompactWordPair(string_view english, string_view translation) ;
+	explicit CompactWordPair(const WordPair& aWordPair) ;
+
+	// Getters (views into the arena, valid until the program ends)
+	string_view getEnglish() const ;
+	string_view getTranslation() const ;
+
+	// Setters (store a new copy in the arena)
+	void setEnglish(string_view english) ;
+	void setTranslation(string_view translation) ;
+
+	// Overloaded Operators
+	bool operator==(const CompactWordPair& rhs) const;
+	bool operator<(const CompactWordPair& rhs) const;
+
+	// Heterogeneous comparisons, as for WordPair
+	bool operator==(string_view rhs) const;
+	bool operator<(string_view rhs) const;
+	bool operator==(const WordPrefix& rhs) const;
+	bool operator<(const WordPrefix& rhs) const;
+
+	// Three-way comparisons, as for WordPair. The prefix kept inline already
+	// plays the part of the one BSTNode caches for WordPair.
+	int compare(const CompactWordPair& rhs) const;
+	int compare(string_view rhs) const;
+	int compare(const WordPrefix& rhs) const;
+
+}; // end of CompactWordPair
+
+static_assert(sizeof(CompactWordPair) == 24, "CompactWordPair is meant to fit in 24 bytes");
@@ -0,0 +1,361 @@
+/*
+ * ConcurrentBST.cpp
+ * 
+ * Description: Thread-safe wrapper around an AVL-balanced binary search tree for
+ *              many concurrent readers and one writer at a time.
+ *
+ * Class invariant: Every published version is an AVL tree.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#include "ConcurrentBST.h"
+
+// Default Constructor
+template <class ElementType>
+ConcurrentBST<ElementType>::ConcurrentBST() {
+    Version* empty = new Version;
+    empty->root = NULL;
+    empty->elementCount = 0;
+    current.store(empty);
+    globalEpoch.store(1);
+    for (int i = 0; i < MAX_READERS; i++)
+        readers[i].epoch.store(0);
+}
+
+// Destructor
+template <class ElementType>
+ConcurrentBST<ElementType>::~ConcurrentBST() {
+    for (size_t i = 0; i < retiredNodes.size(); i++)
+        delete retiredNodes[i].first;
+    for (size_t i = 0; i < retiredVersions.size(); i++)
+        delete retiredVersions[i].first;
+    Version* latest = current.load();
+    deleteNodes(latest->root);
+    delete latest;
+}
+
+//Description: Frees a whole subtree, used when no reader is left
+template <class ElementType>
+void ConcurrentBST<ElementType>::deleteNodes(Node* node) {
+    // Same O(1) extra space walk as BST::deleteNodes
+    while (node != NULL) {
+        if (node->hasLeft()) {
+            Node* leftChild = node->left;
+            node->left = leftChild->right;
+            leftChild->right = node;
+            node = leftChild;
+        } else {
+            Node* rightChild = node->right;
+            delete node;
+            node = rightChild;
+        }
+    }
+}
+
+
+// READERS
+
+//Description: Announces a reader and returns its slot. The epoch is announced
+//             before the version is loaded, so a writer that does not see the
+//             announcement has already published a version this reader will load.
+template <class ElementType>
+int ConcurrentBST<ElementType>::enterRead() const {
+    int slot = (int) (hash<thread::id>()(this_thread::get_id()) % MAX_READERS);
+    while (true) {
+        uint64_t epoch = globalEpoch.load();
+        uint64_t idle = 0;
+        if (readers[slot].epoch.compare_exchange_strong(idle, epoch))
+            return slot;
+        slot = (slot + 1) % MAX_READERS;
+        if (slot == 0)
+            this_thread::yield();   // every slot taken, wait for a reader to leave
+    }
+}
+
+//Description: Frees the slot of a reader that is done with the tree
+template <class ElementType>
+void ConcurrentBST<ElementType>::exitRead(int slot) const {
+    readers[slot].epoch.store(0);
+}
+
+//Description: Lock-free lookup in one version
+template <class ElementType>
+template <class Key>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::findNode(Node* root, const Key& key) {
+    Node* node = root;
+    while (node != NULL && !(node->element == key)) {
+        if (node->element < key)
+            node = node->right;
+        else
+            node = node->left;
+    }
+    return node;
+}
+
+template <class ElementType>
+int ConcurrentBST<ElementType>::getElementCount() const {
+    int slot = enterRead();
+    int count = current.load()->elementCount;
+    exitRead(slot);
+    return count;
+}
+
+template <class ElementType>
+template <class Key>
+bool ConcurrentBST<ElementType>::retrieve(const Key& key, ElementType& result) const {
+    int slot = enterRead();
+    Node* found = findNode(current.load()->root, key);
+    if (found != NULL)
+        result = found->element;
+    exitRead(slot);
+    return found != NULL;
+}
+
+template <class ElementType>
+template <class Key>
+bool ConcurrentBST<ElementType>::contains(const Key& key) const {
+    int slot = enterRead();
+    bool found = findNode(current.load()->root, key) != NULL;
+    exitRead(slot);
+    return found;
+}
+
+template <class ElementType>
+void ConcurrentBST<ElementType>::traverseInOrder(void visit(const ElementType&)) const {
+    traverseInOrder<void (*)(const ElementType&)>(visit);
+}
+
+template <class ElementType>
+template <class Visitor>
+void ConcurrentBST<ElementType>::traverseInOrder(Visitor& visitor) const {
+    int slot = enterRead();
+    vector<Node*> ancestors;
+    Node* node = current.load()->root;
+    while (node != NULL || !ancestors.empty()) {
+        while (node != NULL) {
+            ancestors.push_back(node);
+            node = node->left;
+        }
+        node = ancestors.back();
+        ancestors.pop_back();
+        visitor(static_cast<const ElementType&>(node->element));
+        node = node->right;
+    }
+    exitRead(slot);
+}
+
+
+// WRITERS
+
+template <class ElementType>
+void ConcurrentBST<ElementType>::insert(const ElementType& newElement) {
+    lock_guard<mutex> guard(writerLock);
+    Version* latest = current.load();
+    if (findNode(latest->root, newElement) != NULL) {
+        throw ElementAlreadyExistsInBSTException("Element already present in BST");
+    }
+    Node* newRoot;
+    try {
+        newRoot = insertR(latest->root, newElement);
+    } catch (...) {
+        discardWrite();
+        throw;
+    }
+    publish(newRoot, latest->elementCount + 1);
+}
+
+template <class ElementType>
+void ConcurrentBST<ElementType>::remove(const ElementType& targetElement) {
+    lock_guard<mutex> guard(writerLock);
+    Version* latest = current.load();
+    if (findNode(latest->root, targetElement) == NULL) {
+        throw ElementDoesNotExistInBSTException("Element not found");
+    }
+    Node* newRoot;
+    try {
+        newRoot = removeR(latest->root, targetElement);
+    } catch (...) {
+        discardWrite();
+        throw;
+    }
+    publish(newRoot, latest->elementCount - 1);
+}
+
+//Description: Frees the copies of a write that failed before being published;
+//             the latest version was not touched
+template <class ElementType>
+void ConcurrentBST<ElementType>::discardWrite() {
+    for (size_t i = 0; i < freshNodes.size(); i++)
+        delete freshNodes[i];
+    freshNodes.clear();
+    replacedNodes.clear();
+}
+
+//Description: Returns a node the write in progress may modify: node itself if
+//             it was created by this write, otherwise a copy of it. Only the
+//             O(log2 n) nodes of one path and its rotations are ever copied.
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::writableCopy(Node* node) {
+    for (size_t i = 0; i < freshNodes.size(); i++) {
+        if (freshNodes[i] == node)
+            return node;
+    }
+    Node* copy = new Node(node->element, node->left, node->right);
+    copy->height = node->height;
+    freshNodes.push_back(copy);
+    replacedNodes.push_back(node);
+    return copy;
+}
+
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::insertR(Node* node, const ElementType& element) {
+    if (node == NULL) {
+        Node* leaf = new Node(element);
+        freshNodes.push_back(leaf);
+        return leaf;
+    }
+    Node* copy = writableCopy(node);
+    if (copy->element < element)
+        copy->right = insertR(copy->right, element);
+    else
+        copy->left = insertR(copy->left, element);
+    return rebalance(copy);
+}
+
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::removeR(Node* node, const ElementType& target) {
+    if (node->element == target) {
+        replacedNodes.push_back(node);
+        if (!node->hasLeft())
+            return node->right;
+        if (!node->hasRight())
+            return node->left;
+        // the in-order predecessor takes its place
+        Node* predecessor;
+        Node* newLeft = removeMaxR(node->left, predecessor);
+        predecessor->left = newLeft;
+        predecessor->right = node->right;
+        return rebalance(predecessor);
+    }
+    Node* copy = writableCopy(node);
+    if (copy->element < target)
+        copy->right = removeR(copy->right, target);
+    else
+        copy->left = removeR(copy->left, target);
+    return rebalance(copy);
+}
+
+//Description: Unlinks the largest node of the subtree, hands back a writable copy
+//             of it through max and returns the new root of the subtree
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::removeMaxR(Node* node, Node*& max) {
+    if (!node->hasRight()) {
+        max = writableCopy(node);
+        return node->left;
+    }
+    Node* copy = writableCopy(node);
+    copy->right = removeMaxR(copy->right, max);
+    return rebalance(copy);
+}
+
+template <class ElementType>
+int ConcurrentBST<ElementType>::height(const Node* node) {
+    return (node == NULL) ? 0 : node->height;
+}
+
+template <class ElementType>
+void ConcurrentBST<ElementType>::updateHeight(Node* node) {
+    int leftHeight = height(node->left);
+    int rightHeight = height(node->right);
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+// Same rotations as AVLPolicy, but on writable copies
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::rotateLeft(Node* node) {
+    Node* pivot = writableCopy(node->right);
+    node->right = pivot->left;
+    pivot->left = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::rotateRight(Node* node) {
+    Node* pivot = writableCopy(node->left);
+    node->left = pivot->right;
+    pivot->right = node;
+    updateHeight(node);
+    updateHeight(pivot);
+    return pivot;
+}
+
+//Description: node is writable; returns the root of the rebalanced subtree
+template <class ElementType>
+BSTNode<ElementType>* ConcurrentBST<ElementType>::rebalance(Node* node) {
+    int balance = height(node->left) - height(node->right);
+    if (balance > 1) {
+        if (height(node->left->left) < height(node->left->right)) {
+            node->left = writableCopy(node->left);
+            node->left = rotateLeft(node->left);
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (height(node->right->right) < height(node->right->left)) {
+            node->right = writableCopy(node->right);
+            node->right = rotateRight(node->right);
+        }
+        return rotateLeft(node);
+    }
+    updateHeight(node);
+    return node;
+}
+
+//Description: Publishes the new version, retires what it replaced and frees
+//             whatever no reader can still see
+template <class ElementType>
+void ConcurrentBST<ElementType>::publish(Node* newRoot, int newElementCount) {
+    Version* newVersion = new Version;
+    newVersion->root = newRoot;
+    newVersion->elementCount = newElementCount;
+    Version* oldVersion = current.exchange(newVersion);
+
+    // Readers that announce a later epoch load newVersion or a newer one
+    uint64_t epoch = globalEpoch.fetch_add(1);
+    for (size_t i = 0; i < replacedNodes.size(); i++)
+        retiredNodes.push_back(make_pair(replacedNodes[i], epoch));
+    retiredVersions.push_back(make_pair(oldVersion, epoch));
+    replacedNodes.clear();
+    freshNodes.clear();
+
+    reclaim();
+}
+
+//Description: Frees the retired nodes and versions older than every active reader
+template <class ElementType>
+void ConcurrentBST<ElementType>::reclaim() {
+    uint64_t oldestActive = UINT64_MAX;
+    for (int i = 0; i < MAX_READERS; i++) {
+        uint64_t epoch = readers[i].epoch.load();
+        if (epoch != 0 && epoch < oldestActive)
+            oldestActive = epoch;
+    }
+
+    // Retirement epochs only grow, so what can be freed is a prefix
+    size_t freed = 0;
+    while (freed < retiredNodes.size() && retiredNodes[freed].second < oldestActive) {
+        delete retiredNodes[freed].first;
+        freed++;
+    }
+    retiredNodes.erase(retiredNodes.begin(), retiredNodes.begin() + freed);
+
+    freed = 0;
+    while (freed < retiredVersions.size() && retiredVersions[freed].second < oldestActive) {
+        delete retiredVersions[freed].first;
+        freed++;
+    }
+    retiredVersions.erase(retiredVersions.begin(), retiredVersions.begin() + freed);
+}
@@ -0,0 +1,154 @@
+/*
+ * ConcurrentBST.h
+ * 
+ * Description: Thread-safe wrapper around an AVL-balanced binary search tree for
+ *              many concurrent readers and one writer at a time.
+ *
+ *              Published nodes are never modified. A write copies the nodes on
+ *              the path it changes (path copying), links the copies into a new
+ *              version and publishes that version with one atomic store, so a
+ *              reader always sees a complete tree, old or new, and takes no lock.
+ *
+ *              Nodes replaced by a write are retired, not freed: every reader
+ *              announces the epoch in which it started, and a retired node is only
+ *              freed once no reader that could still hold it is active
+ *              (epoch-based reclamation).
+ *
+ *              Writers are serialized by a mutex. Readers get copies of elements,
+ *              never references into the tree.
+ *
+ * Class invariant: Every published version is an AVL tree.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "BSTNode.h"
+#include "ElementAlreadyExistsInBSTException.h"
+#include "ElementDoesNotExistInBSTException.h"
+
+
+template <class ElementType>
+class ConcurrentBST {
+
+private:
+
+    typedef BSTNode<ElementType> Node;
+
+    // One published version of the tree
+    struct Version {
+        Node* root;
+        int elementCount;
+    };
+
+    // Epoch announced by one active reader, 0 when the slot is free. Padded to a
+    // cache line so readers on different cores do not share one.
+    struct alignas(64) ReaderSlot {
+        atomic<uint64_t> epoch;
+    };
+
+    static const int MAX_READERS = 64;
+
+    atomic<Version*> current;                  // Latest published version
+    atomic<uint64_t> globalEpoch;              // Starts at 1, 0 marks a free reader slot
+    mutable ReaderSlot readers[MAX_READERS];
+
+    mutex writerLock;                          // Serializes writers
+    vector<Node*> freshNodes;                  // Nodes created by the write in progress
+    vector<Node*> replacedNodes;               // Nodes the write in progress unlinked
+    vector<pair<Node*, uint64_t> > retiredNodes;        // Unlinked nodes and their retirement epoch
+    vector<pair<Version*, uint64_t> > retiredVersions;  // Replaced versions and their retirement epoch
+
+    //Description: Announces a reader and returns its slot
+    int enterRead() const;
+
+    //Description: Frees the slot of a reader that is done with the tree
+    void exitRead(int slot) const;
+
+    //Description: Lock-free lookup in one version
+    template <class Key>
+    static Node* findNode(Node* root, const Key& key);
+
+    //Description: Returns a node the write in progress may modify: node itself if
+    //             it was created by this write, otherwise a copy of it
+    Node* writableCopy(Node* node);
+
+    //Description: Path-copying AVL helpers, each returns the new root of the subtree
+    Node* insertR(Node* node, const ElementType& element);
+    Node* removeR(Node* node, const ElementType& target);
+    Node* removeMaxR(Node* node, Node*& max);
+    Node* rebalance(Node* node);
+    Node* rotateLeft(Node* node);
+    Node* rotateRight(Node* node);
+    static int height(const Node* node);
+    static void updateHeight(Node* node);
+
+    //Description: Frees the copies of a write that failed before being published
+    void discardWrite();
+
+    //Description: Publishes the new version, retires what it replaced and frees
+    //             whatever no reader can still see
+    void publish(Node* newRoot, int newElementCount);
+
+    //Description: Frees the retired nodes and versions older than every active reader
+    void reclaim();
+
+    //Description: Frees a whole subtree, used when no reader is left
+    static void deleteNodes(Node* node);
+
+public:
+
+    // Constructors and destructor:
+    ConcurrentBST();                     // Default constructor
+    ~ConcurrentBST();                    // Destructor, no reader may be active
+
+    ConcurrentBST(const ConcurrentBST&) = delete;
+    ConcurrentBST& operator=(const ConcurrentBST&) = delete;
+
+    // Reader operations, lock-free and safe from any number of threads:
+
+    // Description: Returns the number of elements in the latest version
+    // Time efficiency: O(1)
+    int getElementCount() const;
+
+    // Description: Copies the element equal to key into result. Returns false,
+    //              leaving result untouched, if there is none.
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    bool retrieve(const Key& key, ElementType& result) const;
+
+    // Description: Returns true if an element equal to key is in the latest version
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    bool contains(const Key& key) const;
+
+    // Description: Traverses one consistent version in order and "visits" each
+    //              element. Writes published meanwhile are not seen.
+    // Time efficiency: O(n)
+    void traverseInOrder(void visit(const ElementType&)) const;
+
+    // Description: Same as traverseInOrder, for visitors that carry state
+    template <class Visitor>
+    void traverseInOrder(Visitor& visitor) const;
+
+    // Writer operations, serialized with one another:
+
+    // Description: Inserts a new element and publishes the new version
+    // Time efficiency: O(log2 n), plus reclaiming what readers released
+    // Pre Condition: Element not already in the tree
+    void insert(const ElementType& newElement); // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Removes an element and publishes the new version
+    // Time efficiency: O(log2 n), plus reclaiming what readers released
+    void remove(const ElementType& targetElement); // throw(ElementDoesNotExistInBSTException);
+
+}; // end ConcurrentBST
+
+#include "ConcurrentBST.cpp"
@@ -0,0 +1,49 @@
+/*
+ * DictConvert.cpp
+ * 
+ * Description: Converts a text dictionary (one "english:translation" pair per
+ *              line, as read by TApp) into the binary format of MappedDictionary.
+ *
+ *              Usage: DictConvert dataFile.txt dataFile.dict
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include "BST.h"
+#include "WordPair.h"
+#include "MappedDictionary.h"
+#include "DictionaryLoader.h"
+
+using namespace std;
+
+int main(int argc, char *argv[]) {
+
+    if (argc != 3) {
+        cout << "Usage: " << argv[0] << " <text dictionary> <binary dictionary>" << endl;
+        return 1;
+    }
+
+    DictionaryLoader loader;
+    vector<WordPair> wordPairs;
+    vector<WordPair> duplicates;
+    if (!loader.load(argv[1], wordPairs, &duplicates)) {
+        cout << "Unable to open file " << argv[1] << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < duplicates.size(); i++)
+        cout << "Duplicate left out => " << duplicates[i].getEnglish() << ":" << duplicates[i].getTranslation() << endl;
+
+    BST<WordPair> theTranslator;
+    theTranslator.buildFromSorted(make_move_iterator(wordPairs.begin()), make_move_iterator(wordPairs.end()));
+
+    if (!MappedDictionary::save(theTranslator, argv[2])) {
+        cout << "Unable to write file " << argv[2] << endl;
+        return 1;
+    }
+    cout << "Wrote " << theTranslator.getElementCount() << " word pairs to " << argv[2] << endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * DictionaryLoader.cpp
+ *
+ * Description: Parallel loader for text dictionaries.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "DictionaryLoader.h"
+
+// Constructor
+DictionaryLoader::DictionaryLoader(unsigned threadCount) : pool(threadCount) {
+}
+
+//Description: Orders lines by English word only, so equal words keep their file order
+bool DictionaryLoader::englishLess(const Line& lhs, const Line& rhs) {
+    return lhs.english < rhs.english;
+}
+
+//Description: Splits every line of [begin, end) at its first ':' and appends it to lines
+void DictionaryLoader::parse(const char* begin, const char* end, vector<Line>& lines) {
+    while (begin < end) {
+        const char* endOfLine = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if (endOfLine == NULL)
+            endOfLine = end;
+        string_view aLine(begin, endOfLine - begin);
+        size_t pos = aLine.find(':');
+        Line line;
+        line.english = aLine.substr(0, pos);
+        // Same split as the line-by-line loaders: without ':' the whole line is also the translation
+        line.translation = (pos == string_view::npos) ? aLine : aLine.substr(pos + 1);
+        lines.push_back(line);
+        begin = endOfLine + 1;
+    }
+}
+
+//Description: Stable merge of the adjacent sorted runs [runs[i], runs[i+1]) of
+//             from into to, pair by pair, every merge split across the threads.
+//             Returns the boundaries of the merged runs.
+vector<size_t> DictionaryLoader::mergeRound(const vector<Line>& from, vector<Line>& to, const vector<size_t>& runs) {
+    struct Piece {
+        size_t leftBegin, leftEnd, rightBegin, rightEnd, destination;
+    };
+
+    size_t runCount = runs.size() - 1;
+    size_t piecesPerMerge = max<size_t>(1, pool.getThreadCount() / max<size_t>(1, runCount / 2));
+    vector<Piece> pieces;
+    vector<size_t> merged;
+    merged.push_back(0);
+    for (size_t i = 0; i < runCount; i += 2) {
+        size_t leftBegin = runs[i];
+        size_t leftEnd = runs[i + 1];
+        size_t rightEnd = (i + 2 <= runCount) ? runs[i + 2] : leftEnd;   // odd run out: copied alone
+
+        // The left run is cut in equal parts. The right elements less than the first
+        // left element of a part go before it, equal ones after, which keeps the
+        // merge stable.
+        size_t leftSize = leftEnd - leftBegin;
+        size_t rightSplit = leftEnd;
+        size_t parts = min(piecesPerMerge, max<size_t>(1, leftSize));
+        for (size_t part = 0; part < parts; part++) {
+            Piece piece;
+            piece.leftBegin = leftBegin + leftSize * part / parts;
+            piece.leftEnd = leftBegin + leftSize * (part + 1) / parts;
+            piece.rightBegin = rightSplit;
+            if (part + 1 == parts)
+                piece.rightEnd = rightEnd;
+            else
+                piece.rightEnd = lower_bound(from.begin() + rightSplit, from.begin() + rightEnd, from[piece.leftEnd], englishLess) - from.begin();
+            piece.destination = piece.leftBegin + (piece.rightBegin - leftEnd);
+            rightSplit = piece.rightEnd;
+            pieces.push_back(piece);
+        }
+        merged.push_back(rightEnd);
+    }
+
+    pool.run(pieces.size(), [&](size_t index) {
+        const Piece& piece = pieces[index];
+        merge(from.begin() + piece.leftBegin, from.begin() + piece.leftEnd,
+              from.begin() + piece.rightBegin, from.begin() + piece.rightEnd,
+              to.begin() + piece.destination, englishLess);
+    });
+    return merged;
+}
+
+bool DictionaryLoader::load(const string& filename, vector<WordPair>& wordPairs, vector<WordPair>* duplicates) {
+    wordPairs.clear();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = status.st_size;
+    if (size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+        return false;
+    // Unmaps the file when load returns, and when a task or an allocation throws
+    struct Unmapper {
+        void* mapping;
+        size_t size;
+        ~Unmapper() { munmap(mapping, size); }
+    } unmapper = { mapping, size };
+    const char* text = static_cast<const char*>(mapping);
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    // Chunks start right after a line break, so no line is cut in two
+    size_t chunkCount = pool.getThreadCount();
+    vector<size_t> chunkStarts(chunkCount + 1, size);
+    chunkStarts[0] = 0;
+    for (size_t i = 1; i < chunkCount; i++) {
+        size_t start = max(size * i / chunkCount, chunkStarts[i - 1] + 1) - 1;
+        const char* lineBreak = (start < size) ? static_cast<const char*>(memchr(text + start, '\n', size - start)) : NULL;
+        chunkStarts[i] = (lineBreak == NULL) ? size : lineBreak - text + 1;
+    }
+
+    // Parse and sort every chunk on its own thread
+    vector<vector<Line>> chunks(chunkCount);
+    pool.run(chunkCount, [&](size_t index) {
+        parse(text + chunkStarts[index], text + chunkStarts[index + 1], chunks[index]);
+        stable_sort(chunks[index].begin(), chunks[index].end(), englishLess);
+    });
+
+    // Gather the sorted chunks as adjacent runs, then merge the runs pairwise
+    vector<size_t> runs(1, 0);
+    for (size_t i = 0; i < chunkCount; i++)
+        runs.push_back(runs.back() + chunks[i].size());
+    vector<Line> lines(runs.back());
+    vector<Line> scratch(runs.back());
+    pool.run(chunkCount, [&](size_t index) {
+        copy(chunks[index].begin(), chunks[index].end(), lines.begin() + runs[index]);
+        vector<Line>().swap(chunks[index]);
+    });
+    while (runs.size() > 2) {
+        runs = mergeRound(lines, scratch, runs);
+        lines.swap(scratch);
+    }
+    vector<Line>().swap(scratch);
+
+    // Equal words are adjacent and in file order: keep the first of each
+    vector<size_t> kept;
+    kept.reserve(lines.size());
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (i > 0 && lines[i - 1].english == lines[i].english) {
+            if (duplicates != NULL)
+                duplicates->push_back(WordPair(string(lines[i].english), string(lines[i].translation)));
+        } else {
+            kept.push_back(i);
+        }
+    }
+
+    // Only now are the strings copied out of the mapping
+    wordPairs.resize(kept.size());
+    size_t sliceCount = pool.getThreadCount();
+    pool.run(sliceCount, [&](size_t index) {
+        size_t end = kept.size() * (index + 1) / sliceCount;
+        for (size_t i = kept.size() * index / sliceCount; i < end; i++) {
+            const Line& line = lines[kept[i]];
+            wordPairs[i].setEnglish(string(line.english));
+            wordPairs[i].setTranslation(string(line.translation));
+        }
+    });
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+ * DictionaryLoader.h
+ *
+ * Description: Parallel loader for text dictionaries (one "english:translation"
+ *              pair per line, as read by TApp). The file is memory-mapped and cut
+ *              into one chunk per thread at line boundaries. Every chunk is parsed
+ *              into string_views pointing into the mapping and sorted on its own
+ *              thread, the sorted chunks are merged pairwise in rounds, each merge
+ *              itself split across the threads, and only the pairs that survive
+ *              the duplicate check are copied into WordPairs. The result feeds
+ *              BST::buildFromSorted directly.
+ *
+ *              As with buildFromUnsorted, of several lines with the same English
+ *              word the first one in the file is kept and the others are reported
+ *              as duplicates.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ThreadPool.h"
+#include "WordPair.h"
+
+using namespace std;
+
+
+class DictionaryLoader {
+
+private:
+
+    // One parsed line, viewing the mapped file
+    struct Line {
+        string_view english;
+        string_view translation;
+    };
+
+    ThreadPool pool;
+
+    //Description: Orders lines by English word only, so equal words keep their file order
+    static bool englishLess(const Line& lhs, const Line& rhs);
+
+    //Description: Splits every line of [begin, end) at its first ':' and appends it to lines
+    static void parse(const char* begin, const char* end, vector<Line>& lines);
+
+    //Description: Stable merge of the adjacent sorted runs [runs[i], runs[i+1]) of
+    //             from into to, pair by pair, every merge split across the threads.
+    //             Returns the boundaries of the merged runs.
+    vector<size_t> mergeRound(const vector<Line>& from, vector<Line>& to, const vector<size_t>& runs);
+
+public:
+
+    // Description: threadCount threads parse, sort and merge, 0 uses one per hardware thread
+    explicit DictionaryLoader(unsigned threadCount = 0);
+
+    // Description: Reads filename into wordPairs, sorted by English word and without
+    //              duplicates. The lines left out are added to duplicates unless it
+    //              is NULL. Returns false if the file cannot be read.
+    // Post Condition: wordPairs is ready for BST::buildFromSorted
+    // Time efficiency: O((n log n) / threads + n)
+    bool load(const string& filename, vector<WordPair>& wordPairs, vector<WordPair>* duplicates = NULL);
+
+}; // end DictionaryLoader
@@ -0,0 +1,136 @@
+/*
+ * FrozenBST.cpp
+ *
+ * Description: Immutable, read-optimized snapshot of a BST, produced by BST::freeze().
+ *              Elements are stored in Eytzinger (breadth-first) order.
+ *
+ * Class invariant: The implicit tree over elements[1..elementCount] is a BST.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "FrozenBST.h"
+
+// Empty snapshot
+template <class ElementType>
+FrozenBST<ElementType>::FrozenBST() {
+    elements.resize(1);
+    elementCount = 0;
+}
+
+// Description: Lays out the elements of [first, last) in Eytzinger order
+template <class ElementType>
+template <class ForwardIterator>
+FrozenBST<ElementType>::FrozenBST(ForwardIterator first, ForwardIterator last) {
+    elementCount = (int) distance(first, last);
+    elements.resize(elementCount + 1);
+    // Walking the implicit tree in order visits the slots in sorted order
+    for (size_t index = firstInOrder(); index != 0; index = nextInOrder(index)) {
+        elements[index] = *first;
+        ++first;
+    }
+}
+
+//Description: Index of the first element in order (0 when empty)
+template <class ElementType>
+size_t FrozenBST<ElementType>::firstInOrder() const {
+    if (elementCount == 0)
+        return 0;
+    size_t index = 1;
+    while (2 * index <= (size_t) elementCount)
+        index = 2 * index;
+    return index;
+}
+
+//Description: Index of the element that follows index in order (0 after the last)
+template <class ElementType>
+size_t FrozenBST<ElementType>::nextInOrder(size_t index) const {
+    if (2 * index + 1 <= (size_t) elementCount) {
+        // leftmost element of the right subtree
+        index = 2 * index + 1;
+        while (2 * index <= (size_t) elementCount)
+            index = 2 * index;
+        return index;
+    }
+    // climb while coming from a right child, the parent is next
+    while (index & 1)
+        index >>= 1;
+    return index >> 1;
+}
+
+//Description: Branchless descent, returns the index of the first element not
+//             less than key, 0 if every element is less than key
+template <class ElementType>
+template <class Key>
+size_t FrozenBST<ElementType>::lowerBoundIndex(const Key& key) const {
+    const ElementType* base = elements.data();
+    size_t count = (size_t) elementCount;
+    size_t index = 1;
+    while (index <= count) {
+        if (PREFETCH_STRIDE * index <= count)
+            __builtin_prefetch(base + PREFETCH_STRIDE * index);
+        index = 2 * index + (base[index] < key);
+    }
+    // The trailing ones of index are the right turns taken after the last left
+    // turn, which was made at the first element not less than key
+    index >>= __builtin_ffsll(~index);
+    return index;
+}
+
+// Description: Returns the number of elements in the snapshot
+template <class ElementType>
+int FrozenBST<ElementType>::getElementCount() const {
+    return elementCount;
+}
+
+// Description: Retrieves a target element from the snapshot
+template <class ElementType>
+const ElementType& FrozenBST<ElementType>::retrieve(const ElementType& targetElement) const {
+    const ElementType* found = find(targetElement);
+    if (found == NULL) {
+        throw ElementDoesNotExistInBSTException("Element not found in BST");
+    }
+    return *found;
+}
+
+// Description: Returns a pointer to the element equal to key, NULL if there is none
+template <class ElementType>
+template <class Key>
+const ElementType* FrozenBST<ElementType>::find(const Key& key) const {
+    size_t index = lowerBoundIndex(key);
+    if (index == 0 || !(elements[index] == key))
+        return NULL;
+    return &elements[index];
+}
+
+// Description: Returns true if an element equal to key is in the snapshot
+template <class ElementType>
+template <class Key>
+bool FrozenBST<ElementType>::contains(const Key& key) const {
+    return find(key) != NULL;
+}
+
+// Description: traverse the snapshot in order and "visit" each element
+template <class ElementType>
+void FrozenBST<ElementType>::traverseInOrder(void visit(const ElementType&)) const {
+    for (size_t index = firstInOrder(); index != 0; index = nextInOrder(index))
+        visit(elements[index]);
+}
+
+// MIN / MAX
+template <class ElementType>
+const ElementType& FrozenBST<ElementType>::min() const {
+    if (elementCount == 0)
+        throw ElementDoesNotExistInBSTException("No Min element");
+    return elements[firstInOrder()];
+}
+
+template <class ElementType>
+const ElementType& FrozenBST<ElementType>::max() const {
+    if (elementCount == 0)
+        throw ElementDoesNotExistInBSTException("No Max element");
+    size_t index = 1;
+    while (2 * index + 1 <= (size_t) elementCount)
+        index = 2 * index + 1;
+    return elements[index];
+}
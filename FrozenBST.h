@@ -0,0 +1,88 @@
+/*
+ * FrozenBST.h
+ *
+ * Description: Immutable, read-optimized snapshot of a BST, produced by BST::freeze().
+ *              The elements sit in one contiguous array in Eytzinger (breadth-first)
+ *              order: the children of the element at index k are at 2k and 2k + 1.
+ *              A search needs no child pointers, the first levels of the tree share
+ *              the same few cache lines, and the elements a few levels further down
+ *              are prefetched while the current ones are compared.
+ *
+ * Class invariant: The implicit tree over elements[1..elementCount] is a BST.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "ElementDoesNotExistInBSTException.h"
+
+using namespace std;
+
+
+template <class ElementType>
+class FrozenBST {
+
+private:
+
+    // The 16 descendants of index k four levels down are contiguous, starting
+    // at 16k, and get prefetched while index k is being compared
+    static const size_t PREFETCH_STRIDE = 16;
+
+    vector<ElementType> elements;   // elements[0] is unused, the root is elements[1]
+    int elementCount;
+
+    //Description: Index of the first element in order (0 when empty)
+    size_t firstInOrder() const;
+
+    //Description: Index of the element that follows index in order (0 after the last)
+    size_t nextInOrder(size_t index) const;
+
+    //Description: Branchless descent, returns the index of the first element not
+    //             less than key, 0 if every element is less than key
+    template <class Key>
+    size_t lowerBoundIndex(const Key& key) const;
+
+public:
+
+    // Constructors:
+    FrozenBST();                                          // Empty snapshot
+
+    // Description: Lays out the elements of [first, last) in Eytzinger order
+    // Pre Condition: [first, last) is sorted and holds no duplicates
+    // Time efficiency: O(n)
+    template <class ForwardIterator>
+    FrozenBST(ForwardIterator first, ForwardIterator last);
+
+    // Description: Returns the number of elements in the snapshot
+    // Time efficiency: O(1)
+    int getElementCount() const;
+
+    // Description: Retrieves a target element from the snapshot
+    // Time efficiency: O(log2 n)
+    const ElementType& retrieve(const ElementType& targetElement) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns a pointer to the element equal to key, NULL if there is none.
+    //              Key is ElementType or any type it compares with through == and <.
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    const ElementType* find(const Key& key) const;
+
+    // Description: Returns true if an element equal to key is in the snapshot
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    bool contains(const Key& key) const;
+
+    // Description: traverse the snapshot in order and "visit" each element
+    // Time efficiency: O(n)
+    void traverseInOrder(void visit(const ElementType&)) const;
+
+    const ElementType& min() const; // throw(ElementDoesNotExistInBSTException);
+    const ElementType& max() const; // throw(ElementDoesNotExistInBSTException);
+
+}; // end FrozenBST
+
+#include "FrozenBST.cpp"
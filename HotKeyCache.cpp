@@ -0,0 +1,138 @@
+/*
+ * HotKeyCache.cpp
+ *
+ * Description: Bounded lookup cache in front of a dictionary tree.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "HotKeyCache.h"
+
+template <class Tree>
+HotKeyCache<Tree>::HotKeyCache(Tree& tree, size_t slotCount) : tree(tree) {
+    size_t size = 1;
+    while (size < slotCount)
+        size *= 2;
+    slots.resize(size);
+    for (size_t i = 0; i < size; i++)
+        slots[i].generation = 0;
+    slotMask = size - 1;
+    generation = 1;
+    hits = 0;
+    misses = 0;
+}
+
+//Description: Returns the slot of a key with this hash
+template <class Tree>
+typename HotKeyCache<Tree>::Slot& HotKeyCache<Tree>::slotFor(size_t hash) {
+    return slots[hash & slotMask];
+}
+
+//Description: Remembers the answer of a lookup in slot. assign reuses the
+//             storage of the word it replaces, so a warm cache allocates little.
+template <class Tree>
+void HotKeyCache<Tree>::fill(Slot& slot, string_view key, size_t hash, ElementType* element, int pending) {
+    slot.key.assign(key.data(), key.size());
+    slot.hash = hash;
+    slot.element = element;
+    slot.pending = pending;
+    slot.generation = generation;
+}
+
+template <class Tree>
+typename HotKeyCache<Tree>::ElementType* HotKeyCache<Tree>::find(string_view key) {
+    size_t hash = std::hash<string_view>()(key);
+    Slot& slot = slotFor(hash);
+    if (slot.generation == generation && slot.hash == hash && slot.key == key) {
+        hits++;
+        return slot.element;
+    }
+    misses++;
+    ElementType* element = tree.find(key);
+    fill(slot, key, hash, element);
+    return element;
+}
+
+template <class Tree>
+template <class Key>
+int HotKeyCache<Tree>::retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results) {
+    results.assign(keys.size(), NULL);
+    vector<string_view> missedKeys;
+    vector<int> answeredBy(keys.size(), -1);   // lookup in the tree answering each key
+    int found = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        string_view key(keys[i]);
+        size_t hash = std::hash<string_view>()(key);
+        Slot& slot = slotFor(hash);
+        if (slot.generation == generation && slot.hash == hash && slot.key == key) {
+            hits++;
+            if (slot.pending >= 0) {
+                answeredBy[i] = slot.pending;
+            } else {
+                results[i] = slot.element;
+                found += (slot.element != NULL);
+            }
+        } else {
+            misses++;
+            answeredBy[i] = (int) missedKeys.size();
+            fill(slot, key, hash, NULL, answeredBy[i]);
+            missedKeys.push_back(key);
+        }
+    }
+    if (missedKeys.empty())
+        return found;
+
+    vector<ElementType*> missedResults;
+    try {
+        tree.retrieveBatch(missedKeys, missedResults);
+    } catch (...) {
+        invalidate();   // the pending slots refer to this batch
+        throw;
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (answeredBy[i] >= 0) {
+            results[i] = missedResults[answeredBy[i]];
+            found += (results[i] != NULL);
+        }
+    }
+    for (size_t i = 0; i < missedKeys.size(); i++) {
+        size_t hash = std::hash<string_view>()(missedKeys[i]);
+        fill(slotFor(hash), missedKeys[i], hash, missedResults[i]);
+    }
+    return found;
+}
+
+template <class Tree>
+void HotKeyCache<Tree>::insert(const ElementType& newElement) {
+    invalidate();
+    tree.insert(newElement);
+}
+
+template <class Tree>
+void HotKeyCache<Tree>::remove(const ElementType& targetElement) {
+    invalidate();
+    tree.remove(targetElement);
+}
+
+// Description: Drops every cached answer by starting a new generation
+// Time efficiency: O(1)
+template <class Tree>
+void HotKeyCache<Tree>::invalidate() {
+    generation++;
+}
+
+template <class Tree>
+unsigned long HotKeyCache<Tree>::getHits() const {
+    return hits;
+}
+
+template <class Tree>
+unsigned long HotKeyCache<Tree>::getMisses() const {
+    return misses;
+}
+
+template <class Tree>
+void HotKeyCache<Tree>::resetCounters() {
+    hits = 0;
+    misses = 0;
+}
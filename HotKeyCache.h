@@ -0,0 +1,103 @@
+/*
+ * HotKeyCache.h
+ *
+ * Description: Bounded lookup cache in front of a dictionary tree (BST<WordPair>,
+ *              BTree<WordPair> or any tree with the same find and retrieveBatch).
+ *
+ *              Queries for translations are heavily skewed: a few hundred words
+ *              make up most of them. The cache remembers the answer of recent
+ *              lookups, found or not, in a direct-mapped hash table of words, so
+ *              a repeated word costs one hash and one string comparison instead
+ *              of a tree descent.
+ *
+ *              Every slot holds one word; a word that hashes to a taken slot
+ *              replaces the one there. The slots are all dropped at once, in O(1),
+ *              when the tree changes: through insert and remove here, or through
+ *              invalidate() after a change made to the tree directly.
+ *
+ *              A HotKeyCache is not synchronized: lookups fill it, so it belongs
+ *              to one thread.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+
+template <class Tree>
+class HotKeyCache {
+
+private:
+
+    typedef typename remove_pointer<decltype(declval<Tree&>().find(string_view()))>::type ElementType;
+
+    // One cached lookup; generation is 0 for an empty slot
+    struct Slot {
+        string key;
+        size_t hash;
+        ElementType* element;        // NULL for a word known to be absent
+        int pending;                 // while retrieveBatch looks the word up, the index
+                                     // of its lookup in the tree, -1 otherwise
+        uint64_t generation;
+    };
+
+    Tree& tree;
+    vector<Slot> slots;
+    size_t slotMask;                 // slots.size() - 1, a power of 2 minus 1
+    uint64_t generation;             // slots of older generations are empty
+    unsigned long hits;
+    unsigned long misses;
+
+    //Description: Returns the slot of a key with this hash
+    Slot& slotFor(size_t hash);
+
+    //Description: Remembers the answer of a lookup in slot
+    void fill(Slot& slot, string_view key, size_t hash, ElementType* element, int pending = -1);
+
+public:
+
+    // Description: Cache of at most slotCount words (rounded up to a power of 2)
+    //              in front of tree, which must outlive it
+    explicit HotKeyCache(Tree& tree, size_t slotCount = 4096);
+
+    HotKeyCache(const HotKeyCache&) = delete;
+    HotKeyCache& operator=(const HotKeyCache&) = delete;
+
+    // Description: Returns a pointer to the element whose English word is key, NULL
+    //              if there is none. Hits and known misses do not touch the tree.
+    // Time efficiency: O(|key|) on a hit, plus one tree lookup otherwise
+    ElementType* find(string_view key);
+
+    // Description: Same as Tree::retrieveBatch. Only the keys the cache cannot
+    //              answer are looked up in the tree, together, and a word repeated
+    //              within keys is looked up once.
+    template <class Key>
+    int retrieveBatch(const vector<Key>& keys, vector<ElementType*>& results);
+
+    // Description: Insert into and remove from the tree, dropping every cached answer
+    void insert(const ElementType& newElement); // throw(ElementAlreadyExistsInBSTException);
+    void remove(const ElementType& targetElement); // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Drops every cached answer; to be called after the tree was
+    //              changed other than through this cache
+    // Time efficiency: O(1)
+    void invalidate();
+
+    // Description: Lookups answered by the cache, and lookups that went to the tree
+    unsigned long getHits() const;
+    unsigned long getMisses() const;
+    void resetCounters();
+
+}; // end HotKeyCache
+
+#include "HotKeyCache.cpp"
@@ -0,0 +1,70 @@
+/*
+ * KeyPrefix.h
+ *
+ * Description: Comparison helpers used by BST descents.
+ *
+ *              compareKeys(element, key) returns a negative number, zero or a
+ *              positive number as element is less than, equal to or greater than
+ *              key. It calls element.compare(key) when the element type has such a
+ *              member, so that one three-way comparison decides a level instead
+ *              of == followed by <, and falls back on == and < otherwise.
+ *
+ *              KeyPrefix<ElementType> lets an element type have a fixed-width
+ *              prefix of its key cached in every BSTNode. Comparing two prefixes
+ *              as integers must order them like the keys whenever they differ,
+ *              so that a descent only compares the keys themselves when the
+ *              prefixes are equal. The default leaves it disabled; an element
+ *              type enables it by specializing KeyPrefix with
+ *
+ *                static const bool enabled = true;
+ *                static uint64_t of(const ElementType& element);
+ *                static bool ofKey(const Key& key, uint64_t& prefix);  // for each key type,
+ *                                                // false if prefixes cannot order it
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+
+template <class ElementType>
+struct KeyPrefix {
+    static const bool enabled = false;
+};
+
+// Description: First 8 bytes of text, big-endian and zero padded, so that
+//              comparing two such prefixes as integers orders them like the
+//              strings whenever they differ
+inline uint64_t bigEndianPrefix(string_view text) {
+    size_t length = (text.size() < sizeof(uint64_t)) ? text.size() : sizeof(uint64_t);
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; i++)
+        value |= (uint64_t) (unsigned char) text[i] << (8 * (sizeof(uint64_t) - 1 - i));
+    return value;
+}
+
+// True when ElementType has a member int compare(const Key&) const
+template <class ElementType, class Key, class = void>
+struct HasThreeWayCompare : false_type {};
+
+template <class ElementType, class Key>
+struct HasThreeWayCompare<ElementType, Key, void_t<decltype(declval<const ElementType&>().compare(declval<const Key&>()))> >
+    : true_type {};
+
+// Description: Three-way comparison of element with key
+template <class ElementType, class Key>
+inline int compareKeys(const ElementType& element, const Key& key) {
+    if constexpr (HasThreeWayCompare<ElementType, Key>::value) {
+        return element.compare(key);
+    } else {
+        return (element < key) ? -1 : ((element == key) ? 0 : 1);
+    }
+}
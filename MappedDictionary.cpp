@@ -0,0 +1,175 @@
+/*
+ * MappedDictionary.cpp
+ * 
+ * Description: Read-only translator dictionary stored in a compact binary file
+ *              and memory-mapped.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedDictionary.h"
+
+static const char MAGIC[8] = {'B', 'S', 'T', 'D', 'I', 'C', 'T', '\0'};
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// Constructor
+MappedDictionary::MappedDictionary() {
+	mapping = NULL;
+	mappingSize = 0;
+	entries = NULL;
+	blob = NULL;
+	entryCount = 0;
+}
+
+// Destructor
+MappedDictionary::~MappedDictionary() {
+	close();
+}
+
+//Description: FNV-1a hash of size bytes, continuing from hash
+uint64_t MappedDictionary::checksum(const void* data, size_t size, uint64_t hash) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+//Description: Writes sorted pairs in the format described in MappedDictionary.h
+bool MappedDictionary::write(const vector<const WordPair*>& sortedPairs, const string& filename) {
+	vector<Entry> newEntries(sortedPairs.size());
+	string newBlob;
+	for (size_t i = 0; i < sortedPairs.size(); i++) {
+		const string& english = sortedPairs[i]->getEnglish();
+		const string& translation = sortedPairs[i]->getTranslation();
+		newEntries[i].offset = newBlob.size();
+		newEntries[i].englishLength = (uint32_t) english.size();
+		newEntries[i].translationLength = (uint32_t) translation.size();
+		newBlob += english;
+		newBlob += translation;
+	}
+
+	Header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = FORMAT_VERSION;
+	header.entryCount = (uint32_t) newEntries.size();
+	header.blobSize = newBlob.size();
+	header.checksum = checksum(newEntries.data(), newEntries.size() * sizeof(Entry), FNV_OFFSET_BASIS);
+	header.checksum = checksum(newBlob.data(), newBlob.size(), header.checksum);
+
+	ofstream file(filename, ios::binary | ios::trunc);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(newEntries.data()), newEntries.size() * sizeof(Entry));
+	file.write(newBlob.data(), newBlob.size());
+	file.close();
+	return !file.fail();
+}
+
+bool MappedDictionary::open(const string& filename, bool verify) {
+	close();
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat status;
+	if (fstat(fd, &status) != 0 || (size_t) status.st_size < sizeof(Header)) {
+		::close(fd);
+		return false;
+	}
+	void* bytes = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (bytes == MAP_FAILED)
+		return false;
+	mapping = bytes;
+	mappingSize = status.st_size;
+
+	// Header: format, version and sizes must match the file. Each size is checked
+	// against what the file has left after the previous ones, since a sum of
+	// crafted sizes could wrap around.
+	const Header* header = static_cast<const Header*>(mapping);
+	size_t available = mappingSize - sizeof(Header);
+	if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != FORMAT_VERSION
+	    || header->entryCount > available / sizeof(Entry)) {
+		close();
+		return false;
+	}
+	size_t entriesSize = (size_t) header->entryCount * sizeof(Entry);
+	if (header->blobSize != available - entriesSize) {
+		close();
+		return false;
+	}
+	entries = reinterpret_cast<const Entry*>(static_cast<const char*>(mapping) + sizeof(Header));
+	blob = reinterpret_cast<const char*>(entries) + entriesSize;
+	entryCount = header->entryCount;
+
+	if (verify) {
+		bool valid = checksum(entries, mappingSize - sizeof(Header), FNV_OFFSET_BASIS) == header->checksum;
+		for (uint32_t i = 0; valid && i < entryCount; i++) {
+			valid = entries[i].offset <= header->blobSize
+			        && (uint64_t) entries[i].englishLength + entries[i].translationLength <= header->blobSize - entries[i].offset;
+			if (valid && i > 0)
+				valid = englishAt(i - 1) < englishAt(i);
+		}
+		if (!valid) {
+			close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void MappedDictionary::close() {
+	if (mapping != NULL)
+		munmap(mapping, mappingSize);
+	mapping = NULL;
+	mappingSize = 0;
+	entries = NULL;
+	blob = NULL;
+	entryCount = 0;
+}
+
+bool MappedDictionary::isOpen() const {
+	return mapping != NULL;
+}
+
+int MappedDictionary::getElementCount() const {
+	return (int) entryCount;
+}
+
+string_view MappedDictionary::englishAt(uint32_t index) const {
+	return string_view(blob + entries[index].offset, entries[index].englishLength);
+}
+
+string_view MappedDictionary::translationAt(uint32_t index) const {
+	return string_view(blob + entries[index].offset + entries[index].englishLength, entries[index].translationLength);
+}
+
+bool MappedDictionary::find(string_view english, string_view& translation) const {
+	uint32_t low = 0;
+	uint32_t high = entryCount;
+	while (low < high) {
+		uint32_t middle = low + (high - low) / 2;
+		if (englishAt(middle) < english)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if (low == entryCount || englishAt(low) != english)
+		return false;
+	translation = translationAt(low);
+	return true;
+}
+
+void MappedDictionary::traverseInOrder(void visit(string_view english, string_view translation)) const {
+	for (uint32_t i = 0; i < entryCount; i++)
+		visit(englishAt(i), translationAt(i));
+}
@@ -0,0 +1,120 @@
+/*
+ * MappedDictionary.h
+ * 
+ * Description: Read-only translator dictionary stored in a compact binary file
+ *              and memory-mapped, so it is ready as soon as it is opened: no
+ *              parsing, no allocation, and lookups run on the mapped bytes.
+ *
+ *              File layout (native byte order, produced by save):
+ *
+ *                Header   magic "BSTDICT", format version, entry count,
+ *                         blob size and an FNV-1a checksum of everything after it
+ *                Entries  one per word pair, sorted by English word:
+ *                         blob offset, English length, translation length
+ *                Blob     every English word immediately followed by its translation
+ *
+ * Class invariant: When open, every entry lies inside the blob and the entries
+ *                  are sorted by English word.
+ * 
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WordPair.h"
+
+using namespace std;
+
+
+class MappedDictionary {
+
+private:
+
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t entryCount;
+		uint64_t blobSize;
+		uint64_t checksum;           // FNV-1a over the entries and the blob
+	};
+
+	struct Entry {
+		uint64_t offset;             // of the English word in the blob
+		uint32_t englishLength;
+		uint32_t translationLength;  // the translation follows the English word
+	};
+
+	static const uint32_t FORMAT_VERSION = 1;
+
+	void* mapping;                   // Whole file, NULL when closed
+	size_t mappingSize;
+	const Entry* entries;
+	const char* blob;
+	uint32_t entryCount;
+
+	//Description: FNV-1a hash of size bytes, continuing from hash
+	static uint64_t checksum(const void* data, size_t size, uint64_t hash);
+
+	//Description: Writes sorted pairs in the format above, returns false on I/O errors
+	static bool write(const vector<const WordPair*>& sortedPairs, const string& filename);
+
+	string_view englishAt(uint32_t index) const;
+	string_view translationAt(uint32_t index) const;
+
+public:
+
+	// Constructor and destructor
+	MappedDictionary() ;
+	~MappedDictionary() ;
+
+	MappedDictionary(const MappedDictionary&) = delete;
+	MappedDictionary& operator=(const MappedDictionary&) = delete;
+
+	// Description: Saves the word pairs of a translator (BST, BTree, ...) to filename.
+	//              Returns false if the file could not be written.
+	// Time efficiency: O(n)
+	template <class Translator>
+	static bool save(const Translator& translator, const string& filename);
+
+	// Description: Maps filename and checks its header. With verify, the checksum
+	//              and every entry are checked too (one sequential pass over the file).
+	//              Returns false, leaving the dictionary closed, if the file is
+	//              missing, of another format or version, or corrupted.
+	bool open(const string& filename, bool verify = true);
+
+	// Description: Unmaps the file; lookups results obtained before are invalidated
+	void close();
+
+	bool isOpen() const;
+
+	// Description: Returns the number of word pairs
+	int getElementCount() const;
+
+	// Description: Sets translation to the translation of english and returns true,
+	//              or returns false if english is not in the dictionary.
+	//              translation points into the mapping and stays valid until close.
+	// Time efficiency: O(log2 n)
+	bool find(string_view english, string_view& translation) const;
+
+	// Description: Visits every word pair in order of the English words
+	// Time efficiency: O(n)
+	void traverseInOrder(void visit(string_view english, string_view translation)) const;
+
+}; // end MappedDictionary
+
+
+// Collects the pairs in order, then writes them
+template <class Translator>
+bool MappedDictionary::save(const Translator& translator, const string& filename) {
+	struct Collector {
+		vector<const WordPair*> pairs;
+		void operator()(const WordPair& aPair) { pairs.push_back(&aPair); }
+	} collector;
+	translator.traverseInOrder(collector);
+	return write(collector.pairs, filename);
+}
@@ -0,0 +1,147 @@
+/*
+ * NodeAllocator.cpp
+ *
+ * Description: Node allocators for the BST ADT class, selected through its
+ *              third template parameter.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <new>
+#include "NodeAllocator.h"
+
+
+// NEW / DELETE
+template <class ElementType>
+BSTNode<ElementType>* NewDeleteAllocator<ElementType>::allocate() {
+    return static_cast<BSTNode<ElementType>*>(::operator new(sizeof(BSTNode<ElementType>)));
+}
+
+template <class ElementType>
+void NewDeleteAllocator<ElementType>::deallocate(BSTNode<ElementType>* node) {
+    ::operator delete(node);
+}
+
+template <class ElementType>
+void NewDeleteAllocator<ElementType>::reserve(size_t nodeCount) {
+}
+
+
+// POOL
+template <class ElementType>
+BSTNodePool<ElementType>::BSTNodePool() {
+    freeList = NULL;
+    nextUnused = NULL;
+    unusedCount = 0;
+    nextBlockSlots = FIRST_BLOCK_SLOTS;
+    slotsReserved = 0;
+}
+
+template <class ElementType>
+BSTNodePool<ElementType>::~BSTNodePool() {
+    release();
+}
+
+template <class ElementType>
+BSTNodePool<ElementType>::BSTNodePool(BSTNodePool&& aPool) noexcept : blocks(std::move(aPool.blocks)) {
+    freeList = aPool.freeList;
+    nextUnused = aPool.nextUnused;
+    unusedCount = aPool.unusedCount;
+    nextBlockSlots = aPool.nextBlockSlots;
+    slotsReserved = aPool.slotsReserved;
+    aPool.blocks.clear();
+    aPool.release();
+}
+
+template <class ElementType>
+BSTNodePool<ElementType>& BSTNodePool<ElementType>::operator=(BSTNodePool&& aPool) noexcept {
+    if (this != &aPool) {
+        release();
+        blocks.swap(aPool.blocks);
+        freeList = aPool.freeList;
+        nextUnused = aPool.nextUnused;
+        unusedCount = aPool.unusedCount;
+        nextBlockSlots = aPool.nextBlockSlots;
+        slotsReserved = aPool.slotsReserved;
+        aPool.release();
+    }
+    return *this;
+}
+
+//Description: Frees every block and empties the pool
+template <class ElementType>
+void BSTNodePool<ElementType>::release() {
+    for (size_t i = 0; i < blocks.size(); i++)
+        ::operator delete(blocks[i]);
+    blocks.clear();
+    freeList = NULL;
+    nextUnused = NULL;
+    unusedCount = 0;
+    nextBlockSlots = FIRST_BLOCK_SLOTS;
+    slotsReserved = 0;
+}
+
+//Description: Allocates a new block of slotCount slots and makes it the one
+//             slots are carved from
+template <class ElementType>
+void BSTNodePool<ElementType>::grow(size_t slotCount) {
+    blocks.reserve(blocks.size() + 1);
+    nextUnused = static_cast<Slot*>(::operator new(slotCount * sizeof(Slot)));
+    blocks.push_back(nextUnused);
+    unusedCount = slotCount;
+    slotsReserved += slotCount;
+}
+
+template <class ElementType>
+BSTNode<ElementType>* BSTNodePool<ElementType>::allocate() {
+    Slot* slot;
+    if (freeList != NULL) {
+        slot = freeList;
+        freeList = slot->next;
+    } else {
+        if (unusedCount == 0) {
+            grow(nextBlockSlots);
+            if (nextBlockSlots < MAX_BLOCK_SLOTS)
+                nextBlockSlots *= 2;
+        }
+        slot = nextUnused++;
+        unusedCount--;
+    }
+    return reinterpret_cast<BSTNode<ElementType>*>(slot);
+}
+
+template <class ElementType>
+void BSTNodePool<ElementType>::deallocate(BSTNode<ElementType>* node) {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList;
+    freeList = slot;
+}
+
+template <class ElementType>
+void BSTNodePool<ElementType>::reserve(size_t nodeCount) {
+    if (unusedCount >= nodeCount)
+        return;
+    // The rest of the newest block is kept on the free list
+    for (; unusedCount > 0; unusedCount--) {
+        nextUnused->next = freeList;
+        freeList = nextUnused++;
+    }
+    grow(nodeCount);
+}
+
+template <class ElementType>
+size_t BSTNodePool<ElementType>::bytesReserved() const {
+    return slotsReserved * sizeof(Slot);
+}
+
+
+// Description: Bytes an allocator holds while nodeCount of its nodes are in use
+template <class ElementType>
+size_t reservedBytes(const NewDeleteAllocator<ElementType>& allocator, size_t nodeCount) {
+    return nodeCount * sizeof(BSTNode<ElementType>);
+}
+
+template <class ElementType>
+size_t reservedBytes(const BSTNodePool<ElementType>& allocator, size_t nodeCount) {
+    return allocator.bytesReserved();
+}
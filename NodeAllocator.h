@@ -0,0 +1,117 @@
+/*
+ * NodeAllocator.h
+ *
+ * Description: Node allocators for the BST ADT class, selected through its
+ *              third template parameter.
+ *
+ *              NewDeleteAllocator - one heap allocation per node.
+ *              BSTNodePool        - nodes are carved from large contiguous blocks,
+ *                                   recycled through a free list and released a
+ *                                   whole block at a time.
+ *
+ *              An allocator only hands out and takes back raw storage for one
+ *              BSTNode; the BST constructs and destroys the nodes in it. The flag
+ *              bulkRelease tells the BST that destroying the allocator frees every
+ *              node it handed out, so nodes that need no destructor call do not
+ *              have to be visited one by one.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "BSTNode.h"
+
+
+template <class ElementType>
+class NewDeleteAllocator {
+
+public:
+
+    static const bool bulkRelease = false;
+
+    // Description: Returns uninitialized storage for one node
+    BSTNode<ElementType>* allocate();
+
+    // Description: Gives back the storage of a node that has already been destroyed
+    void deallocate(BSTNode<ElementType>* node);
+
+    // Description: Nothing to prepare, every node is allocated on its own
+    void reserve(size_t nodeCount);
+
+}; // end NewDeleteAllocator
+
+
+template <class ElementType>
+class BSTNodePool {
+
+private:
+
+    // A free slot reuses the storage of the node it held to link the free list
+    union Slot {
+        Slot* next;
+        typename aligned_storage<sizeof(BSTNode<ElementType>), alignof(BSTNode<ElementType>)>::type storage;
+    };
+
+    static const size_t FIRST_BLOCK_SLOTS = 64;
+    static const size_t MAX_BLOCK_SLOTS = 65536;
+
+    vector<Slot*> blocks;      // every block, released in the destructor
+    Slot* freeList;            // slots given back by deallocate
+    Slot* nextUnused;          // first never-used slot of the newest block
+    size_t unusedCount;        // never-used slots left in the newest block
+    size_t nextBlockSlots;     // size of the next block, doubles up to MAX_BLOCK_SLOTS
+    size_t slotsReserved;      // in all blocks
+
+    //Description: Allocates a new block of slotCount slots and makes it the one
+    //             slots are carved from
+    void grow(size_t slotCount);
+
+    //Description: Frees every block and empties the pool
+    void release();
+
+public:
+
+    static const bool bulkRelease = true;
+
+    BSTNodePool();
+    ~BSTNodePool();
+
+    BSTNodePool(const BSTNodePool&) = delete;
+    BSTNodePool& operator=(const BSTNodePool&) = delete;
+
+    // Moving a pool hands its blocks over, so the nodes in them stay where they
+    // are; the pool moved from is left empty
+    BSTNodePool(BSTNodePool&& aPool) noexcept;
+    BSTNodePool& operator=(BSTNodePool&& aPool) noexcept;
+
+    // Description: Returns uninitialized storage for one node
+    // Time efficiency: O(1) amortized
+    BSTNode<ElementType>* allocate();
+
+    // Description: Gives back the storage of a node that has already been destroyed
+    // Time efficiency: O(1)
+    void deallocate(BSTNode<ElementType>* node);
+
+    // Description: Makes the next nodeCount allocations that the free list does
+    //              not serve come from one contiguous block
+    // Time efficiency: O(1), plus O(k) to put k unused slots of the newest block on the free list
+    void reserve(size_t nodeCount);
+
+    // Description: Number of bytes held in blocks, used or not
+    size_t bytesReserved() const;
+
+}; // end BSTNodePool
+
+
+// Description: Bytes an allocator holds while nodeCount of its nodes are in use
+template <class ElementType>
+size_t reservedBytes(const NewDeleteAllocator<ElementType>& allocator, size_t nodeCount);
+
+template <class ElementType>
+size_t reservedBytes(const BSTNodePool<ElementType>& allocator, size_t nodeCount);
+
+#include "NodeAllocator.cpp"
@@ -0,0 +1,346 @@
+/*
+ * PersistentBST.cpp
+ *
+ * Description: Persistent (versioned) AVL-balanced binary search tree.
+ *
+ * Class invariant: Every version is an AVL tree.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "PersistentBST.h"
+
+template <class ElementType>
+PersistentBST<ElementType>::Node::Node(const ElementType& element, const Node* left, const Node* right)
+    : element(element), left(left), right(right), references(1) {
+    int leftHeight = PersistentBST::height(left);
+    int rightHeight = PersistentBST::height(right);
+    height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+// Default Constructor
+template <class ElementType>
+PersistentBST<ElementType>::PersistentBST() {
+    root = NULL;
+    elementCount = 0;
+}
+
+//Description: Version made of a root already holding a reference for it
+template <class ElementType>
+PersistentBST<ElementType>::PersistentBST(const Node* root, int elementCount) {
+    this->root = root;
+    this->elementCount = elementCount;
+}
+
+// Copy Constructor: takes a snapshot
+template <class ElementType>
+PersistentBST<ElementType>::PersistentBST(const PersistentBST& aVersion) {
+    root = retain(aVersion.root);
+    elementCount = aVersion.elementCount;
+}
+
+// Move Constructor
+template <class ElementType>
+PersistentBST<ElementType>::PersistentBST(PersistentBST&& aVersion) noexcept {
+    root = aVersion.root;
+    elementCount = aVersion.elementCount;
+    aVersion.root = NULL;
+    aVersion.elementCount = 0;
+}
+
+// Destructor
+template <class ElementType>
+PersistentBST<ElementType>::~PersistentBST() {
+    release(root);
+}
+
+template <class ElementType>
+PersistentBST<ElementType>& PersistentBST<ElementType>::operator=(const PersistentBST& aVersion) {
+    // Retained first, in case aVersion is this version or shares its root
+    const Node* newRoot = retain(aVersion.root);
+    release(root);
+    root = newRoot;
+    elementCount = aVersion.elementCount;
+    return *this;
+}
+
+template <class ElementType>
+PersistentBST<ElementType>& PersistentBST<ElementType>::operator=(PersistentBST&& aVersion) noexcept {
+    if (this != &aVersion) {
+        release(root);
+        root = aVersion.root;
+        elementCount = aVersion.elementCount;
+        aVersion.root = NULL;
+        aVersion.elementCount = 0;
+    }
+    return *this;
+}
+
+// REFERENCE COUNTING
+
+//Description: Adds a reference to node (if any) and returns it
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::retain(const Node* node) {
+    if (node != NULL)
+        node->references.fetch_add(1, memory_order_relaxed);
+    return node;
+}
+
+//Description: Drops a reference to node. The last one frees it and drops its
+//             references to its children, down every subtree no other node or
+//             version holds.
+template <class ElementType>
+void PersistentBST<ElementType>::release(const Node* node) {
+    // acq_rel: whoever frees a node sees every write the other holders made
+    if (node == NULL || node->references.fetch_sub(1, memory_order_acq_rel) != 1)
+        return;
+    vector<const Node*> toFree(1, node);
+    while (!toFree.empty()) {
+        const Node* current = toFree.back();
+        toFree.pop_back();
+        const Node* children[] = { current->left, current->right };
+        for (const Node* child : children) {
+            if (child != NULL && child->references.fetch_sub(1, memory_order_acq_rel) == 1)
+                toFree.push_back(child);
+        }
+        delete current;
+    }
+}
+
+// PATH COPYING
+
+//Description: New node holding a copy of element above left and right, whose
+//             references it takes over (released if the copy throws)
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::makeNode(const ElementType& element, const Node* left, const Node* right) {
+    try {
+        return new Node(element, left, right);
+    } catch (...) {
+        release(left);
+        release(right);
+        throw;
+    }
+}
+
+//Description: Same as makeNode, rotating when left and right differ in height by 2.
+//             The node rotated up is rebuilt rather than modified, since other
+//             versions may share it; its own reference is dropped afterwards.
+//             Each reference is handed to exactly one owner, and the owners
+//             release what they hold if an element copy throws.
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::balance(const ElementType& element, const Node* left, const Node* right) {
+
+    if (height(left) > height(right) + 1) {
+        const Node* result;
+        try {
+            if (height(left->left) >= height(left->right)) {
+                // single right rotation
+                const Node* lowerRight = right;
+                right = NULL;
+                const Node* lower = makeNode(element, retain(left->right), lowerRight);
+                result = makeNode(left->element, retain(left->left), lower);
+            } else {
+                // left-right double rotation
+                const Node* pivot = left->right;
+                const Node* lowerRight = right;
+                right = NULL;
+                const Node* lower = makeNode(element, retain(pivot->right), lowerRight);
+                const Node* upper;
+                try {
+                    upper = makeNode(left->element, retain(left->left), retain(pivot->left));
+                } catch (...) {
+                    release(lower);
+                    throw;
+                }
+                result = makeNode(pivot->element, upper, lower);
+            }
+        } catch (...) {
+            release(left);
+            release(right);
+            throw;
+        }
+        release(left);
+        return result;
+    }
+
+    if (height(right) > height(left) + 1) {
+        const Node* result;
+        try {
+            if (height(right->right) >= height(right->left)) {
+                // single left rotation
+                const Node* lowerLeft = left;
+                left = NULL;
+                const Node* lower = makeNode(element, lowerLeft, retain(right->left));
+                result = makeNode(right->element, lower, retain(right->right));
+            } else {
+                // right-left double rotation
+                const Node* pivot = right->left;
+                const Node* lowerLeft = left;
+                left = NULL;
+                const Node* lower = makeNode(element, lowerLeft, retain(pivot->left));
+                const Node* upper;
+                try {
+                    upper = makeNode(right->element, retain(pivot->right), retain(right->right));
+                } catch (...) {
+                    release(lower);
+                    throw;
+                }
+                result = makeNode(pivot->element, lower, upper);
+            }
+        } catch (...) {
+            release(left);
+            release(right);
+            throw;
+        }
+        release(right);
+        return result;
+    }
+
+    return makeNode(element, left, right);
+}
+
+//Description: Returns a new reference to the root of node's subtree with element
+//             inserted. The new subtree is built on the way back up, so nothing
+//             has been built yet when a duplicate is found.
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::insertR(const Node* node, const ElementType& element) {
+    if (node == NULL)
+        return makeNode(element, NULL, NULL);
+    if (node->element == element)
+        throw ElementAlreadyExistsInBSTException("Element already present in BST");
+    if (node->element < element) {
+        const Node* newRight = insertR(node->right, element);
+        return balance(node->element, retain(node->left), newRight);
+    }
+    const Node* newLeft = insertR(node->left, element);
+    return balance(node->element, newLeft, retain(node->right));
+}
+
+//Description: Returns a new reference to the root of node's subtree without target;
+//             its in-order successor takes the place of a node with two children
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::removeR(const Node* node, const ElementType& target) {
+    if (node == NULL)
+        throw ElementDoesNotExistInBSTException("Element not found");
+    if (node->element == target) {
+        if (node->left == NULL)
+            return retain(node->right);
+        if (node->right == NULL)
+            return retain(node->left);
+        const Node* successor = node->right;
+        while (successor->left != NULL)
+            successor = successor->left;
+        const Node* newRight = removeMinR(node->right);
+        return balance(successor->element, retain(node->left), newRight);
+    }
+    if (node->element < target) {
+        const Node* newRight = removeR(node->right, target);
+        return balance(node->element, retain(node->left), newRight);
+    }
+    const Node* newLeft = removeR(node->left, target);
+    return balance(node->element, newLeft, retain(node->right));
+}
+
+//Description: Returns a new reference to the root of node's subtree without its
+//             smallest element
+template <class ElementType>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::removeMinR(const Node* node) {
+    if (node->left == NULL)
+        return retain(node->right);
+    const Node* newLeft = removeMinR(node->left);
+    return balance(node->element, newLeft, retain(node->right));
+}
+
+template <class ElementType>
+int PersistentBST<ElementType>::height(const Node* node) {
+    return (node == NULL) ? 0 : node->height;
+}
+
+// OPERATIONS
+
+// Description: Returns the number of elements in this version
+// Time efficiency: O(1)
+template <class ElementType>
+int PersistentBST<ElementType>::getElementCount() const {
+    return elementCount;
+}
+
+// Description: Returns a new version holding newElement as well
+// Time efficiency: O(log2 n)
+template <class ElementType>
+PersistentBST<ElementType> PersistentBST<ElementType>::insert(const ElementType& newElement) const {
+    return PersistentBST(insertR(root, newElement), elementCount + 1);
+}
+
+// Description: Returns a new version without targetElement
+// Time efficiency: O(log2 n)
+template <class ElementType>
+PersistentBST<ElementType> PersistentBST<ElementType>::remove(const ElementType& targetElement) const {
+    return PersistentBST(removeR(root, targetElement), elementCount - 1);
+}
+
+//Description: Returns the node holding an element equal to key, NULL if there is none
+template <class ElementType>
+template <class Key>
+const typename PersistentBST<ElementType>::Node* PersistentBST<ElementType>::findNode(const Key& key) const {
+    const Node* current = root;
+    while (current != NULL && !(current->element == key)) {
+        if (current->element < key)
+            current = current->right;
+        else
+            current = current->left;
+    }
+    return current;
+}
+
+// Description: Retrieves a target element from this version
+// Time efficiency: O(log2 n)
+template <class ElementType>
+const ElementType& PersistentBST<ElementType>::retrieve(const ElementType& targetElement) const {
+    const Node* found = findNode(targetElement);
+    if (found == NULL) {
+        throw ElementDoesNotExistInBSTException("Element not found in BST");
+    }
+    return found->element;
+}
+
+template <class ElementType>
+template <class Key>
+const ElementType* PersistentBST<ElementType>::find(const Key& key) const {
+    const Node* found = findNode(key);
+    return (found == NULL) ? NULL : &found->element;
+}
+
+template <class ElementType>
+template <class Key>
+bool PersistentBST<ElementType>::contains(const Key& key) const {
+    return findNode(key) != NULL;
+}
+
+// Description: Visits the elements of this version in order until the visitor returns false
+// Time efficiency: O(n), O(log2 n) extra space
+template <class ElementType>
+template <class Visitor>
+bool PersistentBST<ElementType>::traverse(Visitor&& visitor) const {
+    vector<const Node*> ancestors;
+    const Node* current = root;
+    while (current != NULL || !ancestors.empty()) {
+        while (current != NULL) {
+            ancestors.push_back(current);
+            current = current->left;
+        }
+        current = ancestors.back();
+        ancestors.pop_back();
+        if (!visitElement(visitor, current->element))
+            return false;
+        current = current->right;
+    }
+    return true;
+}
+
+// Description: Returns the number of nodes on the longest root-to-leaf path
+// Time efficiency: O(1)
+template <class ElementType>
+int PersistentBST<ElementType>::height() const {
+    return height(root);
+}
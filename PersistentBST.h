@@ -0,0 +1,144 @@
+/*
+ * PersistentBST.h
+ *
+ * Description: Persistent (versioned) AVL-balanced binary search tree.
+ *
+ *              A PersistentBST is one version of the tree and never changes.
+ *              insert and remove return a new version built by copying only the
+ *              nodes on the path they change (path copying); every other subtree
+ *              is shared with the version they were called on. Nodes count the
+ *              versions and parent nodes that hold them and are freed with the
+ *              last one, so an old version stays readable for as long as a
+ *              PersistentBST holds it.
+ *
+ *              Copying a PersistentBST takes a snapshot in O(1): the copy holds
+ *              the same root. A batch job can keep reading its snapshot while the
+ *              writer goes on producing new versions, e.g.
+ *
+ *                  PersistentBST<WordPair> snapshot = dictionary;
+ *                  dictionary = dictionary.insert(WordPair("snow", "sno"));
+ *
+ *              Shared nodes are never modified and their counts are atomic, so
+ *              different PersistentBST objects can be used from different threads
+ *              even when they share nodes. A single PersistentBST object is not
+ *              synchronized.
+ *
+ * Class invariant: Every version is an AVL tree.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+#include "Traversal.h"
+#include "ElementAlreadyExistsInBSTException.h"
+#include "ElementDoesNotExistInBSTException.h"
+
+
+template <class ElementType>
+class PersistentBST {
+
+private:
+
+    // Node shared by every version that reaches it, immutable once linked
+    struct Node {
+        ElementType element;
+        const Node* left;
+        const Node* right;
+        int height;
+        mutable atomic<int> references;   // versions and parent nodes holding it
+
+        Node(const ElementType& element, const Node* left, const Node* right);
+    };
+
+    const Node* root;
+    int elementCount;
+
+    //Description: Version made of a root already holding a reference for it
+    PersistentBST(const Node* root, int elementCount);
+
+    //Description: Adds a reference to node (if any) and returns it
+    static const Node* retain(const Node* node);
+
+    //Description: Drops a reference to node, freeing it and releasing its children
+    //             when it was the last one
+    static void release(const Node* node);
+
+    //Description: New node holding a copy of element above left and right, whose
+    //             references it takes over (released if the copy throws)
+    static const Node* makeNode(const ElementType& element, const Node* left, const Node* right);
+
+    //Description: Same as makeNode, rotating when left and right differ in height
+    //             by 2, as after an insert or remove below an AVL node
+    static const Node* balance(const ElementType& element, const Node* left, const Node* right);
+
+    //Description: Path-copying helpers, each returns a new reference to the root of
+    //             the new subtree and builds nothing when it throws
+    static const Node* insertR(const Node* node, const ElementType& element);
+    static const Node* removeR(const Node* node, const ElementType& target);
+    static const Node* removeMinR(const Node* node);
+
+    static int height(const Node* node);
+
+    //Description: Returns the node holding an element equal to key, NULL if there is none
+    template <class Key>
+    const Node* findNode(const Key& key) const;
+
+public:
+
+    // Constructors and destructor:
+    PersistentBST();                                 // Empty version
+    PersistentBST(const PersistentBST& aVersion);    // Snapshot, O(1)
+    PersistentBST(PersistentBST&& aVersion) noexcept;
+    ~PersistentBST();                                // Releases this version
+
+    PersistentBST& operator=(const PersistentBST& aVersion);
+    PersistentBST& operator=(PersistentBST&& aVersion) noexcept;
+
+    // Description: Returns the number of elements in this version
+    // Time efficiency: O(1)
+    int getElementCount() const;
+
+    // Description: Returns a new version holding newElement as well. This
+    //              version is unchanged and shares all but O(log2 n) nodes with it.
+    // Time efficiency: O(log2 n)
+    // Pre Condition: Element not already in this version
+    PersistentBST insert(const ElementType& newElement) const; // throw(ElementAlreadyExistsInBSTException);
+
+    // Description: Returns a new version without targetElement, sharing all but
+    //              O(log2 n) nodes with this unchanged one
+    // Time efficiency: O(log2 n)
+    PersistentBST remove(const ElementType& targetElement) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Retrieves a target element from this version
+    // Time efficiency: O(log2 n)
+    const ElementType& retrieve(const ElementType& targetElement) const; // throw(ElementDoesNotExistInBSTException);
+
+    // Description: Returns a pointer to the element equal to key, NULL if there is
+    //              none. Key is ElementType or any type it compares with through
+    //              == and <, as for BST::find. The pointer stays valid as long as
+    //              a version holding the element does.
+    // Time efficiency: O(log2 n)
+    template <class Key>
+    const ElementType* find(const Key& key) const;
+
+    template <class Key>
+    bool contains(const Key& key) const;
+
+    // Description: Visits the elements of this version in order with any callable
+    //              taking a const ElementType&, see BST::traverse. Returns false
+    //              if the visitor stopped it.
+    // Time efficiency: O(n), O(log2 n) extra space
+    template <class Visitor>
+    bool traverse(Visitor&& visitor) const;
+
+    // Description: Returns the number of nodes on the longest root-to-leaf path (0 when empty)
+    // Time efficiency: O(1)
+    int height() const;
+
+}; // end PersistentBST
+
+#include "PersistentBST.cpp"
@@ -0,0 +1,55 @@
+/*
+ * StringArena.cpp
+ *
+ * Description: Append-only storage for many small strings.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include <algorithm>
+#include "StringArena.h"
+
+// Constructor
+StringArena::StringArena() {
+    next = NULL;
+    remaining = 0;
+    reserved = 0;
+}
+
+// Destructor
+StringArena::~StringArena() {
+    for (size_t i = 0; i < blocks.size(); i++)
+        delete[] blocks[i];
+}
+
+const char* StringArena::store(string_view first, string_view second) {
+    size_t size = first.size() + second.size();
+    if (size == 0)
+        return NULL;
+
+    lock_guard<mutex> guard(lock);
+    if (size > remaining) {
+        // Strings too long to share a block get one of their own, and the
+        // current block keeps being filled
+        size_t blockSize = (size > BLOCK_SIZE / 4) ? size : BLOCK_SIZE;
+        blocks.reserve(blocks.size() + 1);
+        char* block = new char[blockSize];
+        blocks.push_back(block);
+        reserved += blockSize;
+        if (blockSize != BLOCK_SIZE) {
+            copy(second.begin(), second.end(), copy(first.begin(), first.end(), block));
+            return block;
+        }
+        next = block;
+        remaining = blockSize;
+    }
+    char* stored = next;
+    next = copy(second.begin(), second.end(), copy(first.begin(), first.end(), next));
+    remaining -= size;
+    return stored;
+}
+
+size_t StringArena::bytesReserved() const {
+    lock_guard<mutex> guard(lock);
+    return reserved;
+}
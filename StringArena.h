@@ -0,0 +1,53 @@
+/*
+ * StringArena.h
+ *
+ * Description: Append-only storage for many small strings. Strings are copied
+ *              back to back into large blocks, so each one costs its own bytes
+ *              and nothing else: no heap header, no capacity slack, no
+ *              per-string allocation. A stored string never moves and lives as
+ *              long as the arena; nothing is given back before that.
+ *
+ *              store may be called from several threads at once.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+
+class StringArena {
+
+private:
+
+    static const size_t BLOCK_SIZE = 1 << 20;
+
+    vector<char*> blocks;      // every block, released in the destructor
+    char* next;                // first free byte of the newest block
+    size_t remaining;          // free bytes left in the newest block
+    size_t reserved;           // bytes held in blocks, used or not
+    mutable mutex lock;
+
+public:
+
+    StringArena();
+    ~StringArena();
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    // Description: Copies first and then second into the arena, one right after
+    //              the other, and returns where the copy of first starts
+    // Time efficiency: O(size of the strings)
+    const char* store(string_view first, string_view second = string_view());
+
+    // Description: Number of bytes held in blocks, used or not
+    size_t bytesReserved() const;
+
+}; // end StringArena
@@ -17,76 +17,180 @@
 #include <iomanip>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <iterator>
+#include <sys/stat.h>
+#include <csignal>
+#include <thread>
+#include <unistd.h>
 #include "BST.h"
+#include "BTree.h"
 #include "WordPair.h"
+#include "MappedDictionary.h"
+#include "DictionaryLoader.h"
+#include "HotKeyCache.h"
 #include "ElementAlreadyExistsInBSTException.h"
 #include "ElementDoesNotExistInBSTException.h"
 
 
-void display(WordPair& anElement) {
-  cout << anElement.getEnglish() << ":" << anElement.getTranslation() << endl;
-} // end of display
+// Translator backend, chosen at compile time: build with -DTAPP_BTREE to use the
+// wide-node BTree instead of the BST
+#ifdef TAPP_BTREE
+typedef BTree<WordPair> Translator;
+#else
+typedef BST<WordPair> Translator;
+#endif
+
+// Built with -DBST_ENABLE_STATS, TApp writes the stats of its BST translator to
+// stderr when it exits and whenever it receives SIGUSR1 (kill -USR1 <pid>)
+#if defined(BST_ENABLE_STATS) && !defined(TAPP_BTREE)
+#define TAPP_STATS
+#endif
+
+
+void displayMapped(string_view english, string_view translation) {
+  cout << english << ":" << translation << '\n';
+} // end of displayMapped
+
+// True if the binary dictionary exists and is not older than the text one
+bool isUpToDate(const string& dictFilename, const string& filename) {
+  struct stat dictStatus;
+  struct stat textStatus;
+  if (stat(dictFilename.c_str(), &dictStatus) != 0)
+    return false;
+  return stat(filename.c_str(), &textStatus) != 0 || dictStatus.st_mtime >= textStatus.st_mtime;
+} // end of isUpToDate
+
+#ifdef TAPP_STATS
+// Formats the report first and writes it with a single system call, so it is
+// safe from the signal thread while the main one prints translations
+void dumpStats(const Translator& theTranslator) {
+  ostringstream report;
+  report << "Translator stats:" << '\n';
+  theTranslator.stats().print(report);
+  string text = report.str();
+  if (write(STDERR_FILENO, text.data(), text.size()) < 0)
+    return;
+} // end of dumpStats
+
+// Runs on its own thread once the translator is built: lookups only read the
+// tree and the counters are atomic, so it can report while they go on
+void watchStatsSignal(const Translator* theTranslator) {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGUSR1);
+  int received;
+  while (sigwait(&signals, &received) == 0)
+    dumpStats(*theTranslator);
+} // end of watchStatsSignal
+#endif
+
+// Same commands as main, served straight from a memory-mapped binary dictionary
+int runMapped(const MappedDictionary& theDictionary, int argc, char *argv[]) {
+  string aWord = "";
+  string_view translation;
+
+  if ( ( argc > 1 ) && ( strcmp(argv[1], "Display") == 0) ) {
+      theDictionary.traverseInOrder(displayMapped);
+  }
+  else if (argc == 1) {
+     // while user has not entered CTRL+D
+     while ( getline(cin, aWord) ) {
+        if (theDictionary.find(aWord, translation))
+            cout << aWord << ":" << translation << endl;
+        else
+            cout << "Translation for '" << aWord << "' not found!" << endl;
+     }
+  }
+  return 0;
+} // end of runMapped
 
 
 int main(int argc, char *argv[]) {
 
-  BST<WordPair>* theTranslator = new BST<WordPair>();
+  // cin gets its own buffer, which lets the stdin loop see how many words are waiting
+  ios::sync_with_stdio(false);
+
+#ifdef TAPP_STATS
+  // Blocked before the loader starts its threads, which inherit the mask, so
+  // SIGUSR1 waits for watchStatsSignal instead of terminating TApp
+  sigset_t statsSignal;
+  sigemptyset(&statsSignal);
+  sigaddset(&statsSignal, SIGUSR1);
+  pthread_sigmask(SIG_BLOCK, &statsSignal, NULL);
+#endif
+
+  string filename = "dataFile.txt";
+  string dictFilename = "dataFile.dict";   // made from filename by DictConvert
+
+  // A binary dictionary starts instantly: it is mapped, not parsed and rebuilt
+  MappedDictionary theDictionary;
+  if (isUpToDate(dictFilename, filename) && theDictionary.open(dictFilename)) {
+    return runMapped(theDictionary, argc, argv);
+  }
+
+  Translator* theTranslator = new Translator();
     
-  string aLine = "";
   string aWord = "";
-  string englishW = "";
-  string translationW = "";
-  string filename = "dataFile.txt";
-  string delimiter = ":";
-  size_t pos = 0;
-  WordPair translated;
- 
-  
-  ifstream myfile (filename);
-  if (myfile.is_open()) {
-  	// cout << "Reading from a file:" << endl;
-    while ( getline (myfile, aLine) )
-    {
-       // cout << aLine << '\n';   // For debugging purposes
-       pos = aLine.find(delimiter);
-       englishW = aLine.substr(0, pos);
-       aLine.erase(0, pos + delimiter.length());
-       translationW = aLine;
-       //cout << "Read: " << englishW << ":" << translationW << endl;  // For debugging purposes
-       WordPair aWordPair(englishW, translationW);
-       //cout << "Read: " <<  aWordPair.getEnglish() << ":" << aWordPair.getTranslation() << endl;  // For debugging purposes
-       try {
-  	   		theTranslator->insert(aWordPair);
-  	   }
-  	   catch (ElementAlreadyExistsInBSTException& anException) {
-  	       cout << anException.what( ) << " => " <<  aWordPair.getEnglish() << ":" << aWordPair.getTranslation() << endl;
-  	   }
+
+  // The file is parsed, sorted and de-duplicated on every core, then the
+  // translator is linked in linear time, keeping the first translation of
+  // every word and reporting the others
+  DictionaryLoader loader;
+  vector<WordPair> wordPairs;
+  vector<WordPair> duplicates;
+  if (loader.load(filename, wordPairs, &duplicates)) {
+    theTranslator->buildFromSorted(make_move_iterator(wordPairs.begin()), make_move_iterator(wordPairs.end()));
+    for (size_t i = 0; i < duplicates.size(); i++) {
+        cout << ElementAlreadyExistsInBSTException("Element already present in BST").what( ) << " => "
+             << duplicates[i].getEnglish() << ":" << duplicates[i].getTranslation() << endl;
     }
-    myfile.close();
+#ifdef TAPP_STATS
+    thread(watchStatsSignal, theTranslator).detach();
+#endif
 
     // If user entered "Display" at the command line
     if ( ( argc > 1 ) && ( strcmp(argv[1], "Display") == 0) ) {
         // cout << "Printing the Translator:" << endl; // For debugging purposes
-        theTranslator->traverseInOrder(display);
+        theTranslator->traverse([](const WordPair& anElement) {
+            cout << anElement.getEnglish() << ":" << anElement.getTranslation() << '\n';
+        });
     }
     else if (argc == 1) {
+       // Words already waiting in the input buffer (e.g. a file piped in) are
+       // translated together in one retrieveBatch; a word typed at the terminal
+       // is still answered as soon as it is entered. Queries repeat the same
+       // few words, so answers already looked up come from the cache.
+       HotKeyCache<Translator> cache(*theTranslator);
+       const size_t maxBatch = 256;
+       vector<string> words(maxBatch);
+       vector<string_view> keys;
+       vector<WordPair*> translations;
        // while user has not entered CTRL+D
-       while ( getline(cin, aWord) ) {   
-          // cout << "Read: " << aWord << endl; // For debugging purposes
-          WordPair aWordPair(aWord);
-          //cout << "The word to translate is: " << aWordPair.getEnglish() << ":" << aWordPair.getTranslation() << endl; // For debugging purposes
-          try {
-              translated = theTranslator->retrieve(aWordPair);
-              cout << translated.getEnglish() << ":" << translated.getTranslation() << endl;
-          }
-          catch (ElementDoesNotExistInBSTException& anException) {
-              cout << "Translation for '" << aWordPair.getEnglish() << "' not found!" << endl;
+       while ( getline(cin, words[0]) ) {   
+          size_t count = 1;
+          while ( count < maxBatch && cin.rdbuf()->in_avail() > 0 && getline(cin, words[count]) )
+             count++;
+          keys.assign(words.begin(), words.begin() + count);
+          cache.retrieveBatch(keys, translations);
+          for (size_t i = 0; i < count; i++) {
+             if (translations[i] != NULL)
+                 cout << translations[i]->getEnglish() << ":" << translations[i]->getTranslation() << endl;
+             else
+                 cout << "Translation for '" << words[i] << "' not found!" << endl;
           }
        }
+#ifdef TAPP_STATS
+       cerr << "Cache: " << cache.getHits() << " hits, " << cache.getMisses() << " misses" << endl;
+#endif
     }
   }
   else 
     cout << "Unable to open file"; 
 
+#ifdef TAPP_STATS
+  cout.flush();
+  dumpStats(*theTranslator);
+#endif
   return 0;
 }
\ No newline at end of file
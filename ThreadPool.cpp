@@ -0,0 +1,97 @@
+/*
+ * ThreadPool.cpp
+ *
+ * Description: Fixed set of worker threads that run batches of independent
+ *              tasks.
+ *
+ * Date of last modification: October 2026
+ */
+
+#include "ThreadPool.h"
+
+// Constructor
+ThreadPool::ThreadPool(unsigned threadCount) {
+    task = NULL;
+    taskCount = 0;
+    nextTask = 0;
+    runningWorkers = 0;
+    batch = 0;
+    stopping = false;
+
+    if (threadCount == 0)
+        threadCount = thread::hardware_concurrency();
+    for (unsigned i = 1; i < threadCount; i++)
+        workers.push_back(thread(&ThreadPool::work, this));
+}
+
+// Destructor
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    batchStarted.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+//Description: Body of a worker thread
+void ThreadPool::work() {
+    unsigned long lastBatch = 0;
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        batchStarted.wait(guard, [&] { return stopping || batch != lastBatch; });
+        if (stopping)
+            return;
+        lastBatch = batch;
+        runningWorkers++;
+        runTasks(guard);
+        if (--runningWorkers == 0)
+            batchFinished.notify_one();
+    }
+}
+
+//Description: Runs tasks of the current batch until none is left. Called
+//             with lock held, returns with lock held.
+void ThreadPool::runTasks(unique_lock<mutex>& guard) {
+    while (nextTask < taskCount) {
+        size_t index = nextTask++;
+        guard.unlock();
+        try {
+            (*task)(index);
+            guard.lock();
+        }
+        catch (...) {
+            guard.lock();
+            if (!failure)
+                failure = current_exception();
+            nextTask = taskCount;
+        }
+    }
+}
+
+unsigned ThreadPool::getThreadCount() const {
+    return (unsigned) workers.size() + 1;
+}
+
+void ThreadPool::run(size_t taskCount, const function<void(size_t)>& task) {
+    unique_lock<mutex> guard(lock);
+    this->task = &task;
+    this->taskCount = taskCount;
+    nextTask = 0;
+    failure = NULL;
+    batch++;
+    if (taskCount > 1)
+        batchStarted.notify_all();
+
+    runTasks(guard);
+    // Workers that picked up a task may still be running it
+    batchFinished.wait(guard, [&] { return runningWorkers == 0; });
+    this->task = NULL;
+
+    if (failure) {
+        exception_ptr thrown = failure;
+        failure = NULL;
+        rethrow_exception(thrown);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * ThreadPool.h
+ *
+ * Description: Fixed set of worker threads that run batches of independent
+ *              tasks. run(taskCount, task) calls task(0) ... task(taskCount - 1)
+ *              spread over the workers and the calling thread, and returns once
+ *              every call has finished. The threads are started once and reused
+ *              by every batch.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+class ThreadPool {
+
+private:
+
+    vector<thread> workers;
+    mutex lock;
+    condition_variable batchStarted;    // workers wait here between batches
+    condition_variable batchFinished;   // run waits here for the workers
+
+    const function<void(size_t)>* task; // task of the current batch
+    size_t taskCount;
+    size_t nextTask;                    // next index to hand out
+    size_t runningWorkers;              // workers still inside the current batch
+    unsigned long batch;                // number of batches started so far
+    exception_ptr failure;              // first exception thrown by a task
+    bool stopping;
+
+    //Description: Body of a worker thread
+    void work();
+
+    //Description: Runs tasks of the current batch until none is left. Called
+    //             with lock held, returns with lock held.
+    void runTasks(unique_lock<mutex>& guard);
+
+public:
+
+    // Description: Starts threadCount - 1 workers, the caller of run being the
+    //              last thread. 0 uses one thread per hardware thread.
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Description: Number of threads running tasks, the caller included
+    unsigned getThreadCount() const;
+
+    // Description: Calls task(i) for every i in [0, taskCount) and waits for all of
+    //              them. If a task throws, the remaining tasks are skipped and the
+    //              first exception is rethrown here.
+    // Pre Condition: Not called from inside a task
+    void run(size_t taskCount, const function<void(size_t)>& task);
+
+}; // end ThreadPool
@@ -0,0 +1,30 @@
+/*
+ * Traversal.h
+ *
+ * Description: Traversal orders accepted by BST::traverse and BTree::traverse,
+ *              and the helper they use to call a visitor.
+ *
+ * Date of last modification: October 2026
+ */
+
+#pragma once
+
+#include <type_traits>
+
+using namespace std;
+
+
+enum TraversalOrder { PRE_ORDER, IN_ORDER, POST_ORDER };
+
+// Description: Calls visitor(element) and returns false if the traversal has to
+//              stop there. A visitor returning bool stops it by returning false;
+//              a visitor returning void never stops it.
+template <class Visitor, class ElementType>
+inline bool visitElement(Visitor& visitor, ElementType& element) {
+    if constexpr (is_void<decltype(visitor(element))>::value) {
+        visitor(element);
+        return true;
+    } else {
+        return static_cast<bool>(visitor(element));
+    }
+}
@@ -7,6 +7,7 @@
  * Date of last modification: July 2017
  */
  
+#include <utility>
 #include "WordPair.h"
 
 // Constructors
@@ -16,40 +17,76 @@ WordPair::WordPair() {
 }
 
 WordPair::WordPair(string english) {
-	this->english = english;
-	this->translation = "";
+	this->english = std::move(english);
 }
 
 WordPair::WordPair(string english, string translation) {
-	this->english = english;
-	this->translation = translation;
+	this->english = std::move(english);
+	this->translation = std::move(translation);
 }
 
 // Getters
-string WordPair::getEnglish() const {
+const string& WordPair::getEnglish() const {
 	return this->english;
 }
 
-string WordPair::getTranslation() const {
+const string& WordPair::getTranslation() const {
 	return this->translation;
 }
 
 // Setters
 void WordPair::setEnglish(string english) {
-	this->english = english;
+	this->english = std::move(english);
 }
 
 void WordPair::setTranslation(string translation) {
-	this->translation = translation;
+	this->translation = std::move(translation);
 }
 
 // Overloaded Operators
 bool WordPair::operator==(const WordPair& rhs) const {
 
-	return (this->english.compare(rhs.getEnglish()) ) == 0;
+	return (this->english.compare(rhs.english) ) == 0;
 } // end of operator==
 
 bool WordPair::operator<(const WordPair& rhs) const {
 
-	return (this->english.compare(rhs.getEnglish()) ) < 0;
-} // end of operator<
\ No newline at end of file
+	return (this->english.compare(rhs.english) ) < 0;
+} // end of operator<
+
+bool WordPair::operator==(string_view rhs) const {
+
+	return (this->english.compare(rhs) ) == 0;
+} // end of operator==
+
+bool WordPair::operator<(string_view rhs) const {
+
+	return (this->english.compare(rhs) ) < 0;
+} // end of operator<
+
+bool WordPair::operator==(const WordPrefix& rhs) const {
+
+	return (this->english.compare(0, rhs.prefix.size(), rhs.prefix) ) == 0;
+} // end of operator==
+
+bool WordPair::operator<(const WordPrefix& rhs) const {
+
+	// A word starting with the prefix is never less than it
+	return (this->english.compare(rhs.prefix) ) < 0;
+} // end of operator<
+
+int WordPair::compare(const WordPair& rhs) const {
+
+	return this->english.compare(rhs.english);
+} // end of compare
+
+int WordPair::compare(string_view rhs) const {
+
+	return this->english.compare(rhs);
+} // end of compare
+
+int WordPair::compare(const WordPrefix& rhs) const {
+
+	// Every word starting with the prefix is equal to it
+	return this->english.compare(0, rhs.prefix.size(), rhs.prefix);
+} // end of compare
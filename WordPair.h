@@ -9,10 +9,22 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include "KeyPrefix.h"
 
 using namespace std;
 
+// Search key matching every English word that starts with prefix. The words it
+// matches are contiguous in sorted order, so BST::equal_range(WordPrefix(p))
+// returns them all.
+struct WordPrefix {
+	string_view prefix;
+
+	explicit WordPrefix(string_view prefix) : prefix(prefix) {}
+};
+
 class WordPair {
 
 private:
@@ -20,16 +32,17 @@ private:
 	string translation;
 	
 public:
-	// Constructors
+	// Constructors (strings are taken by value and moved in, so callers
+	// passing temporaries or std::move pay for no copy)
 	WordPair() ;
-	WordPair(string english) ;
+	explicit WordPair(string english) ;
 	WordPair(string english, string translation) ;
 
-	// Getters
-	string getEnglish() const ;
-	string getTranslation() const ;
+	// Getters (return references, so reading a word never allocates)
+	const string& getEnglish() const ;
+	const string& getTranslation() const ;
 
-	// Setters
+	// Setters (also move their argument in)
 	void setEnglish(string english) ;
 	void setTranslation(string translation) ;
 
@@ -37,4 +50,33 @@ public:
 	bool operator==(const WordPair& rhs) const;
 	bool operator<(const WordPair& rhs) const;
 
-}; // end of WordPair.h
\ No newline at end of file
+	// Heterogeneous comparisons against an English word, used to search a
+	// BST<WordPair> by key without building a WordPair (accept string,
+	// string_view and const char*)
+	bool operator==(string_view rhs) const;
+	bool operator<(string_view rhs) const;
+
+	// Prefix comparisons: == when the English word starts with the prefix,
+	// < when it comes before every word that does
+	bool operator==(const WordPrefix& rhs) const;
+	bool operator<(const WordPrefix& rhs) const;
+
+	// Three-way comparisons (negative, zero or positive as this pair is less than,
+	// equal to or greater than rhs), which let a BST descent decide a level with
+	// a single string comparison
+	int compare(const WordPair& rhs) const;
+	int compare(string_view rhs) const;
+	int compare(const WordPrefix& rhs) const;
+
+}; // end of WordPair.h
+
+// BSTNode<WordPair> caches the first 8 bytes of the English word, see KeyPrefix.h.
+// A WordPrefix matches words with other first bytes, so it is compared in full.
+template <>
+struct KeyPrefix<WordPair> {
+	static const bool enabled = true;
+	static uint64_t of(const WordPair& element) { return bigEndianPrefix(element.getEnglish()); }
+	static bool ofKey(const WordPair& key, uint64_t& prefix) { prefix = of(key); return true; }
+	static bool ofKey(string_view key, uint64_t& prefix) { prefix = bigEndianPrefix(key); return true; }
+	static bool ofKey(const WordPrefix& key, uint64_t& prefix) { return false; }
+};